@@ -0,0 +1,92 @@
+// adc_capture.h
+// Header file for free-running DMA capture of the antenna ADC
+// The ADC converts continuously; two chained DMA channels ping-pong
+// between the two halves of a buffer, so samples land in RAM with no
+// CPU work at all. The consumer gets whole blocks by pointer.
+//
+// On the host (unit tests, built with -DHOST_TEST), the same API is
+// backed by a stand-in that is fed recorded traces instead of the ADC.
+// Anything else (the device build) gets the DMA path.
+
+#ifndef ADC_CAPTURE_H
+#define ADC_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================
+// CONSTANTS
+// ============================================================
+
+#define ADC_CAPTURE_BLOCK_BITS 8                           // 256 samples per block
+#define ADC_CAPTURE_BLOCK_SIZE (1 << ADC_CAPTURE_BLOCK_BITS)
+#define ADC_CAPTURE_BLOCK_BYTES (ADC_CAPTURE_BLOCK_SIZE * sizeof(uint16_t))
+#define ADC_CAPTURE_BLOCKS 2                               // One per DMA channel
+
+// ============================================================
+// STRUCTURES
+// ============================================================
+
+// Each capture owns its buffer, but there is only one ADC: its input
+// select, FIFO, clock divider and DREQ are shared, so only one capture
+// runs at a time (adc_capture_start() refuses a second one until the
+// first is stopped). The buffer's alignment makes the whole struct that
+// aligned: declare captures statically or on the stack, not with malloc().
+typedef struct {
+    // Both blocks back to back. Each DMA channel wraps its write address
+    // inside its own block (ring mode), which needs the block aligned to
+    // its size; aligning the pair to twice that covers both.
+    uint16_t buffer[ADC_CAPTURE_BLOCKS * ADC_CAPTURE_BLOCK_SIZE]
+        __attribute__((aligned(ADC_CAPTURE_BLOCKS * ADC_CAPTURE_BLOCK_BYTES)));
+
+    uint16_t* blocks[ADC_CAPTURE_BLOCKS];  // The two halves of buffer
+    int dma_channel[ADC_CAPTURE_BLOCKS];   // Channel filling each half
+    uint8_t adc_channel;     // ADC input, selected when started
+    float sample_rate_hz;    // Conversion rate, set when started
+    int last_block;          // Block last handed out (-1 = none yet)
+    uint32_t blocks_acquired; // Blocks handed out so far
+
+    // Host stand-in only: where the next fed sample goes
+    int writing_block;       // Block being written (-1 = stopped)
+    size_t write_position;   // Next sample in that block
+} AdcCapture;
+
+// ============================================================
+// FUNCTION DECLARATIONS
+// ============================================================
+
+// Set up the input pin and both DMA channels (does not start them)
+// The shared ADC is only touched by adc_capture_start(), so this is
+// safe while another capture is running.
+// adc_channel: ADC input to capture (0-3)
+// sample_rate_hz: Conversions per second (up to 500 kHz)
+void adc_capture_init(AdcCapture* capture, uint8_t adc_channel, float sample_rate_hz);
+
+// Start the free-running capture: takes over the ADC (input, FIFO and
+// rate) and starts the DMA chain
+// Returns: false (and does nothing) if another capture is running
+bool adc_capture_start(AdcCapture* capture);
+
+// Stop the capture and release the ADC for another one
+void adc_capture_stop(AdcCapture* capture);
+
+// Get the newest complete block, if it hasn't been handed out yet
+// Returns: ADC_CAPTURE_BLOCK_SIZE samples (zero-copy, inside the DMA
+// buffer), or NULL if no new block has completed.
+// The block stays valid for one block period (until the DMA comes back
+// around to it); call at least once per block period to see every block.
+const uint16_t* adc_capture_acquire(AdcCapture* capture);
+
+#if defined(HOST_TEST)
+// Host stand-in: write samples into the buffer exactly as the DMA
+// would (fills a block, then switches to the other)
+void adc_capture_feed(AdcCapture* capture, const uint16_t* samples, size_t count);
+
+// Host stand-in: read a recorded trace, one ADC value per line (the
+// format of a serial printf("%u\n") log)
+// Returns: number of samples read
+size_t adc_capture_read_trace(const char* path, uint16_t* samples, size_t max_samples);
+#endif
+
+#endif // ADC_CAPTURE_H
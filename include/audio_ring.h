@@ -0,0 +1,78 @@
+// audio_ring.h
+// Header file for the audio block ring between synthesis and output
+// The synthesis loop (one producer) renders straight into a free block
+// of the ring and commits it; the output driver (one consumer) reads
+// committed blocks in place and releases them. No copies, no locks:
+// every call finishes in a fixed number of steps (wait-free).
+
+#ifndef AUDIO_RING_H
+#define AUDIO_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================
+// CONSTANTS
+// ============================================================
+
+#define AUDIO_RING_BLOCKS 4             // Blocks in the ring (power of 2)
+#define AUDIO_RING_MASK (AUDIO_RING_BLOCKS - 1)
+#define AUDIO_RING_BLOCK_SIZE 256       // Samples per block (AUDIO_BUFFER_SIZE)
+
+// Producer and consumer indices live on separate cache lines, so one
+// side's writes never invalidate the other's (64 bytes covers the
+// hosts the tests run on; on the RP2350 it only costs a little RAM)
+#define AUDIO_RING_ALIGN 64
+
+// ============================================================
+// STRUCTURES
+// ============================================================
+
+typedef struct {
+    int16_t blocks[AUDIO_RING_BLOCKS][AUDIO_RING_BLOCK_SIZE]
+        __attribute__((aligned(AUDIO_RING_ALIGN)));
+
+    // Producer's line: head counts committed blocks (up forever; the
+    // slot is head & MASK). cached_tail is the producer's last look at
+    // tail, so it only reads the consumer's line when the ring seems full.
+    volatile uint32_t head __attribute__((aligned(AUDIO_RING_ALIGN)));
+    uint32_t cached_tail;
+    uint32_t overruns;       // Acquires that found the ring full
+
+    // Consumer's line, the same the other way round
+    volatile uint32_t tail __attribute__((aligned(AUDIO_RING_ALIGN)));
+    uint32_t cached_head;
+    uint32_t underruns;      // Acquires that found the ring empty
+} AudioRing;
+
+// ============================================================
+// FUNCTION DECLARATIONS
+// ============================================================
+
+// Empty the ring and clear the counters
+void audio_ring_init(AudioRing* ring);
+
+// Producer side: the next free block to render into (in place)
+// Returns: AUDIO_RING_BLOCK_SIZE samples, or NULL if the ring is full
+// (counted as an overrun: use audio_ring_space() to wait instead)
+int16_t* audio_ring_acquire_write(AudioRing* ring);
+
+// Producer side: hand the acquired block to the consumer
+void audio_ring_commit_write(AudioRing* ring);
+
+// Consumer side: the oldest committed block (read it in place)
+// Returns: AUDIO_RING_BLOCK_SIZE samples, or NULL if the ring is empty
+// (counted as an underrun: the output has nothing to play)
+const int16_t* audio_ring_acquire_read(AudioRing* ring);
+
+// Consumer side: give the acquired block back to the producer
+void audio_ring_release_read(AudioRing* ring);
+
+// Blocks the producer could acquire now (not counted as an overrun)
+uint32_t audio_ring_space(AudioRing* ring);
+
+// Blocks the consumer could acquire now (not counted as an underrun)
+uint32_t audio_ring_available(AudioRing* ring);
+
+#endif // AUDIO_RING_H
@@ -7,6 +7,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include "tuning.h"
 
 // ============================================================
 // CONSTANTS
@@ -15,27 +17,155 @@
 #define NUM_NOTES 60              // Total number of notes in our range
 #define FIRST_NOTE_FREQ 65.41f    // C2 - lowest note
 #define REFERENCE_A4 440.0f       // A4 - standard tuning reference
+#define A4_NOTE_INDEX 49          // Index of A4 in note_table
 #define SAMPLE_RATE 44100         // Audio sample rate (Hz)
 
+// ============================================================
+// NOTE TABLE
+// ============================================================
+
+// Global array holding all 60 correct note frequencies
+// Index 0 = C2 (65.41 Hz), Index 49 = A4 (440 Hz), Index 59 = C7 (2093 Hz)
+extern float note_table[NUM_NOTES];
+
+// ============================================================
+// SCALES
+// ============================================================
+
+// Pitch classes for the root key (C = 0 ... B = 11)
+typedef enum {
+    NOTE_C = 0, NOTE_CS, NOTE_D, NOTE_DS, NOTE_E, NOTE_F,
+    NOTE_FS, NOTE_G, NOTE_GS, NOTE_A, NOTE_AS, NOTE_B
+} PitchClass;
+
+// Built-in scales, as 12-bit masks of the semitones above the root
+// (bit 0 = root, bit 11 = major 7th)
+typedef enum {
+    SCALE_CHROMATIC = 0,    // All 12 notes (same as find_nearest_note)
+    SCALE_MAJOR,            // 1 2 3 4 5 6 7 (root C = the white keys)
+    SCALE_MINOR,            // 1 2 b3 4 5 b6 b7 (natural minor)
+    SCALE_PENTATONIC,       // 1 2 3 5 6 (major pentatonic)
+    SCALE_BLUES,            // 1 b3 4 b5 5 b7
+    SCALE_CUSTOM            // Mask passed to scale_set_custom()
+} ScaleType;
+
+#define SCALE_MASK_CHROMATIC  0x0FFF
+#define SCALE_MASK_MAJOR      0x0AB5
+#define SCALE_MASK_MINOR      0x05AD
+#define SCALE_MASK_PENTATONIC 0x0295
+#define SCALE_MASK_BLUES      0x04E9
+
+// The quantizer for one scale + root
+// For every semitone k of note_table it stores the nearest allowed note at
+// or below k and the nearest allowed note above k, so quantizing is one
+// table fetch plus one comparison. Rebuilding it is two passes over
+// NUM_NOTES bytes (a few microseconds), so scales can change on stage.
+typedef struct {
+    ScaleType type;               // Which scale this is
+    uint16_t mask;                // Allowed semitones above the root
+    uint8_t root;                 // Root key (PitchClass)
+    uint8_t below[NUM_NOTES];     // Allowed note index at or below k
+    uint8_t above[NUM_NOTES];     // Allowed note index above k
+    uint32_t generation;          // Changes on every rebuild (voices use it
+                                  // to notice a scale switch)
+} Scale;
+
+// The scale process_autotune() snaps to (chromatic after autotune_init)
+extern Scale active_scale;
+
 // ============================================================
 // AUTO-TUNE STATE STRUCTURE
 // ============================================================
 
+// Shape of the glide between two notes (all computed in semitones, so
+// upward and downward glides take the same musical time)
+typedef enum {
+    GLIDE_EXPONENTIAL = 0,  // One-pole: fast start, slow settle; glide_ms
+                            // is the time constant
+    GLIDE_LINEAR = 1,       // Constant semitones per second; lands exactly
+                            // glide_ms after the note change
+    GLIDE_SCURVE = 2        // Smoothstep: eases out and in; lands exactly
+                            // glide_ms after the note change
+} GlideCurve;
+
+// Settings for one auto-tuned voice
+typedef struct {
+    float strength;          // How much correction (0.0 = none, 1.0 = full)
+    float glide_rate;        // How fast to transition (0.0 = slow, 1.0 = instant)
+                             // per call of process_autotune_state()
+    const Scale* scale;      // Scale to snap to (NULL = follow active_scale)
+    float glide_ms;          // Glide time constant for process_autotune_block()
+                             // (time to cover 63% of the way, 0 = instant)
+    float rate_hz;           // Rate of the samples passed to the block function
+    float dead_zone_cents;   // Hysteresis: how far past the boundary between
+                             // two notes the input must go to switch
+    float min_dwell_ms;      // Shortest time on a note before switching again
+    GlideCurve glide_curve;  // Shape of the glide (see GlideCurve)
+    const Tuning* tuning;    // Microtonal tuning to snap to instead of the
+                             // scale (NULL = 12-TET note_table + scale)
+    float vibrato_cutoff_hz; // Vibrato-preserving mode: only the pitch
+                             // center (input low-passed at this cutoff) is
+                             // corrected, faster vibrato passes through.
+                             // ~2 Hz keeps 4-7 Hz hand vibrato. 0 = off
+} AutoTuneConfig;
+
+// Full correction, smooth exponential glide, follow the active scale,
+// 10 cent dead zone, no minimum dwell, 12-TET, vibrato corrected too
+#define AUTOTUNE_DEFAULT_CONFIG \
+    { 1.0f, 0.3f, NULL, 15.0f, (float)SAMPLE_RATE, 10.0f, 0.0f, GLIDE_EXPONENTIAL, NULL, 0.0f }
+
 // This structure holds all the state information for auto-tune
 // It remembers where we are and where we're going
+// One per voice; keep several in an array so a block loop can walk them
+// in order (harmonizer, second antenna, ...)
 typedef struct {
     float current_freq;      // The frequency we're currently outputting
     float target_freq;       // The correct note we're gliding toward
     float last_input_freq;   // Previous input (to detect changes)
-} AutoTuneState;
+    
+    // The glide runs in the pitch domain: semitones relative to A4
+    float current_pitch;     // Pitch we're currently outputting
+    float target_pitch;      // Pitch of target_freq
+    float glide_start_pitch; // Where the current linear/S-curve glide began
+    float glide_position;    // Progress of that glide (0.0 to 1.0)
+    GlideCurve glide_curve;  // From AutoTuneConfig
 
-// ============================================================
-// NOTE TABLE
-// ============================================================
+    float strength;          // From AutoTuneConfig
+    float glide_rate;        // From AutoTuneConfig
+    const Scale* scale;      // From AutoTuneConfig
+    float glide_ms;          // From AutoTuneConfig
+    float rate_hz;           // From AutoTuneConfig
+    float glide_coefficient; // One-pole coefficient for glide_ms at rate_hz
+    float glide_step;        // Linear/S-curve progress per sample
+    float dead_zone_cents;   // From AutoTuneConfig
+    float min_dwell_ms;      // From AutoTuneConfig
+    const Tuning* tuning;    // From AutoTuneConfig
+    float vibrato_cutoff_hz; // From AutoTuneConfig
+    
+    // Vibrato-preserving mode
+    // center_freq follows the input through a one-pole low-pass; the
+    // note is chosen from it, and input / center_freq (the vibrato, as a
+    // ratio) is put back on the corrected pitch
+    float center_freq;       // Slow pitch center (Hz, 0 = not started)
+    float center_coefficient; // One-pole coefficient at rate_hz (0 = off)
+    
+    // Note-switch hysteresis
+    // While the input stays inside [zone_low, zone_high] the target note
+    // is kept without any lookup. The zone edges are the log-domain
+    // midpoints to the neighbouring notes, widened by the dead zone.
+    int target_note;         // note_table (or tuning->freqs) index of the
+                             // target (-1 = none)
+    float zone_low;          // Stay-zone edges (Hz)
+    float zone_high;
+    uint32_t zone_generation; // Scale (or Tuning) generation the zone was
+                              // built for
+    float dead_zone_ratio;   // 2^(dead_zone_cents / 1200)
+    uint32_t dwell_samples;  // min_dwell_ms in samples at rate_hz
+    uint32_t dwell_remaining; // Samples left before the next switch is allowed
+} AutoTuneState;
 
-// Global array holding all 60 correct note frequencies
-// Index 0 = C2 (65.41 Hz), Index 49 = A4 (440 Hz), Index 59 = C7 (2093 Hz)
-extern float note_table[NUM_NOTES];
+// The voice used by the single-voice wrappers (process_autotune() etc.)
+extern AutoTuneState autotune_state;
 
 // ============================================================
 // FUNCTION DECLARATIONS
@@ -45,18 +175,85 @@ extern float note_table[NUM_NOTES];
 void autotune_init(void);
 
 // Find the nearest correct musical note to the input frequency
+// Constant time: a fast log2 gives the semitone number directly, then only
+// the two neighbouring notes are compared
 // input_freq: The raw frequency from the antenna (Hz)
 // Returns: The frequency of the nearest correct note (Hz)
 float find_nearest_note(float input_freq);
 
+// Reference implementation of find_nearest_note(): linear scan of the
+// whole note table. Slow, used by the tests to check the fast version.
+float find_nearest_note_reference(float input_freq);
+
+// Switch the active scale
+// type: One of the built-in scales (SCALE_CUSTOM keeps the current mask)
+// root: Root key (NOTE_C ... NOTE_B)
+void scale_set(ScaleType type, uint8_t root);
+
+// Switch to a custom scale
+// mask: Allowed semitones above the root (bit 0 = root), 0 = chromatic
+void scale_set_custom(uint16_t mask, uint8_t root);
+
+// Build a quantizer for any scale (for callers that keep their own)
+void scale_build(Scale* scale, ScaleType type, uint16_t mask, uint8_t root);
+
+// Find the nearest note of a scale to the input frequency
+// Returns: The frequency of the nearest allowed note (Hz)
+float quantize_to_scale(const Scale* scale, float input_freq);
+
+// Same, returning the note_table index of the note
+int quantize_to_scale_index(const Scale* scale, float input_freq);
+
 // Process auto-tune correction on the input frequency
 // input_freq: Raw frequency from antenna (Hz)
 // strength: How much correction to apply (0.0 = none, 1.0 = full)
 // glide_rate: How fast to transition (0.0 = slow, 1.0 = instant)
+// The target is the nearest note of active_scale
 // Returns: The corrected frequency to use for waveform generation (Hz)
 float process_autotune(float input_freq, float strength, float glide_rate);
 
 // Reset auto-tune state (call when changing profiles)
 void reset_autotune(void);
 
+// ------------------------------------------------------------
+// Multi-voice API: every function works on the voice passed in, so any
+// number of voices can run side by side
+// ------------------------------------------------------------
+
+// Set up one voice from a config (autotune_init() must have run once)
+void autotune_state_init(AutoTuneState* state, const AutoTuneConfig* config);
+
+// Process one voice with its own strength, glide and scale
+// Returns: The corrected frequency (Hz)
+float process_autotune_state(AutoTuneState* state, float input_freq);
+
+// Process a block of n input frequencies for one voice
+// The glide follows state->glide_ms in real time, whatever rate_hz is, so
+// control-rate and audio-rate callers sound the same. The glide
+// coefficient is cached in the voice when glide_ms or rate_hz is set,
+// so a block (even of one sample) needs no expf.
+// in: Raw frequencies (Hz)
+// out: Corrected frequencies (Hz), must not overlap in
+void process_autotune_block(AutoTuneState* state, const float* restrict in,
+                            float* restrict out, size_t n);
+
+// Change the glide time or the rate of one voice (always through this,
+// not by writing the fields: it refreshes the cached glide coefficient)
+void autotune_set_glide_time(AutoTuneState* state, float glide_ms, float rate_hz);
+
+// Change the vibrato-preserving cutoff of one voice (0 = off)
+void autotune_set_vibrato(AutoTuneState* state, float vibrato_cutoff_hz);
+
+// Change the note-switch hysteresis of one voice
+// dead_zone_cents: Extra distance past a note boundary before switching
+// min_dwell_ms: Shortest time on a note before switching again
+void autotune_set_hysteresis(AutoTuneState* state, float dead_zone_cents, float min_dwell_ms);
+
+// Process count voices: outputs[i] = correction of inputs[i] by voices[i]
+void process_autotune_voices(AutoTuneState* voices, const float* inputs,
+                             float* outputs, size_t count);
+
+// Reset one voice (keeps its config)
+void reset_autotune_state(AutoTuneState* state);
+
 #endif // AUTOTUNE_H
\ No newline at end of file
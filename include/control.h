@@ -0,0 +1,64 @@
+// control.h
+// Header file for the control-rate stage
+// Antenna readings are taken at a control rate (~1.4 kHz), smoothed by
+// the CIC decimator (decimator.h), and queued in a ring buffer; the
+// audio loop takes one block's worth of control points and
+// interpolates between them
+
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================
+// CONSTANTS
+// ============================================================
+
+#define CONTROL_RING_SIZE 32      // Control points in the ring (power of 2)
+#define CONTROL_RING_MASK (CONTROL_RING_SIZE - 1)
+
+// ============================================================
+// STRUCTURES
+// ============================================================
+
+// One control-rate sample of the player's input
+typedef struct {
+    float frequency;         // Pitch antenna (Hz)
+    float volume;            // Volume antenna (0.0 = silent, 1.0 = full)
+} ControlPoint;
+
+// Ring buffer of control points
+// One producer (the control core / core 1 loop) and one consumer (the
+// audio loop on core 0): each index is only written by its own side, so
+// no lock is needed
+typedef struct {
+    ControlPoint points[CONTROL_RING_SIZE];
+    volatile uint32_t head;  // Next slot to write (producer)
+    volatile uint32_t tail;  // Next slot to read (consumer)
+    ControlPoint last;       // Last point read, repeated on underrun
+    uint32_t overruns;       // Points dropped because the ring was full
+    uint32_t underruns;      // Points repeated because the ring was empty
+} ControlRing;
+
+// ============================================================
+// FUNCTION DECLARATIONS
+// ============================================================
+
+// Empty the ring; start (underrun) value = initial
+void control_ring_init(ControlRing* ring, ControlPoint initial);
+
+// Producer side: queue one point
+// Returns: false if the ring was full (point dropped)
+bool control_ring_push(ControlRing* ring, const ControlPoint* point);
+
+// Consumer side: take count points into out[]
+// Always fills all count entries: on underrun the last point is
+// repeated. If the producer has run ahead (its clock is a little faster
+// than the audio clock), points older than one extra block are skipped
+// so latency stays bounded.
+// Returns: number of fresh points
+size_t control_ring_pop(ControlRing* ring, ControlPoint* out, size_t count);
+
+#endif // CONTROL_H
@@ -0,0 +1,62 @@
+// decimator.h
+// Header file for the antenna oversampling front-end
+// The ADC runs CIC_DECIMATION times faster than the control rate (via
+// the DMA capture); a 2-stage CIC filter plus a 3-tap droop-compensation
+// FIR average each group of readings down to one control-rate value
+// with 4 extra bits (12.4 fixed point, 16 bits)
+//
+// Averaging R readings of white noise gains about log2(R) / 2 bits, so
+// R = 256 turns an ADC with ~1 LSB of noise into 14+ effective bits
+
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================
+// CONSTANTS
+// ============================================================
+
+#define CIC_STAGES 2              // Integrator/comb pairs
+#define CIC_DECIMATION_BITS 8
+#define CIC_DECIMATION (1 << CIC_DECIMATION_BITS)   // 256 ADC samples per output
+#define DECIMATOR_EXTRA_BITS 4    // Output = ADC value × 16 (12.4)
+
+// CIC gain is R^N = 2^(N × log2 R); shifting by this minus the extra
+// bits leaves a 16-bit result
+#define CIC_OUTPUT_SHIFT (CIC_STAGES * CIC_DECIMATION_BITS - DECIMATOR_EXTRA_BITS)
+
+// ============================================================
+// STRUCTURES
+// ============================================================
+
+// All arithmetic is uint32_t and allowed to wrap: a CIC filter's output
+// is exact as long as the final value fits (12 + 16 = 28 bits here;
+// a third stage would need 36 and 64-bit registers)
+typedef struct {
+    uint32_t integrator[CIC_STAGES];
+    uint32_t comb_delay[CIC_STAGES];
+    uint32_t phase;           // Input samples into the current output
+    int32_t fir_history[2];   // Previous two CIC outputs (for the FIR)
+    uint32_t warmup;          // CIC outputs still to drop at startup
+    bool primed;              // false until the first output
+} Decimator;
+
+// ============================================================
+// FUNCTION DECLARATIONS
+// ============================================================
+
+// Clear the filter state
+void decimator_init(Decimator* decimator);
+
+// Filter and decimate a block of raw 12-bit ADC samples
+// n need not be a multiple of CIC_DECIMATION: the filter carries its
+// phase from one call to the next. The first CIC_STAGES outputs after
+// init (the combs filling up) are dropped.
+// out: Room for n / CIC_DECIMATION + 1 values, 12.4 fixed point
+// Returns: number of values written
+size_t decimator_process(Decimator* decimator, const uint16_t* in, size_t n, uint16_t* out);
+
+#endif // DECIMATOR_H
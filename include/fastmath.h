@@ -0,0 +1,60 @@
+// fastmath.h
+// Fast approximations of the math used in the per-sample paths
+// (pitch <-> frequency conversions), so no powf/exp2f/log2f runs per sample
+//
+// Error bounds, measured against libm (test_fastmath.c):
+//   fast_exp2f     0.03 cents   (relative error 1.5e-5)
+//   fast_log2f     0.06 cents   (absolute error 5e-5 octaves)
+//   fast_exp2_q16  0.05 cents   for results >= 1.0 (Q16 rounding below)
+//   fast_log2_q16  0.07 cents   (table + Q16 rounding)
+// 1 cent = 1/1200 octave, so all of these are far below what anyone
+// can hear (~5 cents).
+
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+#include <stdint.h>
+
+// ============================================================
+// CONSTANTS
+// ============================================================
+
+#define EXP2_TABLE_BITS 6                       // 64 segments per octave
+#define EXP2_TABLE_SIZE (1 << EXP2_TABLE_BITS)
+
+#define LOG2_TABLE_BITS 6                       // 64 segments per octave
+#define LOG2_TABLE_SIZE (1 << LOG2_TABLE_BITS)
+
+// 2^(i / 64) for i = 0..64 (one extra entry for the interpolation)
+extern const float exp2_table[EXP2_TABLE_SIZE + 1];
+
+// log2(1 + i / 64) for i = 0..64
+extern const float log2_table[LOG2_TABLE_SIZE + 1];
+
+// Same two tables in Q2.30 for the fixed-point versions
+extern const uint32_t exp2_table_q30[EXP2_TABLE_SIZE + 1];
+extern const uint32_t log2_table_q30[LOG2_TABLE_SIZE + 1];
+
+// ============================================================
+// FUNCTION DECLARATIONS
+// ============================================================
+
+// 2^x for x in about -126..+127
+// Table lookup with linear interpolation for the fraction, exponent bits
+// for the integer part. Max relative error ~1.5e-5 (0.03 cents).
+float fast_exp2f(float x);
+
+// log2(x) for positive, normal floats
+// Exponent bits for the integer part, table lookup with linear
+// interpolation for the mantissa. Max error ~5e-5 (0.06 cents).
+float fast_log2f(float x);
+
+// 2^x, x in Q16.16 (-16.0 to +16.0), result in Q16.16
+// Integer-only version of fast_exp2f() (saturates at UINT32_MAX)
+uint32_t fast_exp2_q16(int32_t x);
+
+// log2(x), x in Q16.16 (> 0), result in Q16.16
+// Integer-only version of fast_log2f() (x = 0 gives INT32_MIN)
+int32_t fast_log2_q16(uint32_t x);
+
+#endif // FASTMATH_H
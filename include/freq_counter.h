@@ -0,0 +1,95 @@
+// freq_counter.h
+// Header file for the non-blocking frequency-counter service
+// Measures the antenna oscillator with the clock block's frequency
+// counter (FC0): a measurement is started, the caller carries on, and
+// each result is published to a latest-value slot (and an optional
+// callback) when a later poll finds it done.
+//
+// On the host (built with -DHOST_TEST) the FC0 registers are a plain
+// struct (same layout as the SDK's fc_hw_t), so tests can play the
+// hardware's part.
+
+#ifndef FREQ_COUNTER_H
+#define FREQ_COUNTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if !defined(HOST_TEST)
+#include "hardware/structs/clocks.h"
+#else
+// Register-level mock of the frequency counter (hardware/structs/clocks.h)
+typedef struct {
+    volatile uint32_t ref_khz;
+    volatile uint32_t min_khz;
+    volatile uint32_t max_khz;
+    volatile uint32_t delay;
+    volatile uint32_t interval;
+    volatile uint32_t src;       // Writing starts a measurement
+    volatile uint32_t status;
+    volatile uint32_t result;
+} fc_hw_t;
+
+#define CLOCKS_FC0_STATUS_DONE_BITS 0x00000010u
+#define CLOCKS_FC0_STATUS_RUNNING_BITS 0x00000100u
+#define CLOCKS_FC0_RESULT_KHZ_LSB 5
+#endif
+
+// ============================================================
+// CONSTANTS
+// ============================================================
+
+// Measurement time is 0.98 us × 2^interval (datasheet table 542):
+// interval 15 = 32 ms and the finest resolution, 10 = 1 ms
+#define FREQ_COUNTER_MIN_INTERVAL 8     // 0.25 ms, coarse
+#define FREQ_COUNTER_MAX_INTERVAL 15    // 32 ms, fine
+#define FREQ_COUNTER_FAST_CENTS 20.0f   // Pitch moving faster: shorten
+#define FREQ_COUNTER_SLOW_CENTS 2.0f    // Pitch steadier than this: lengthen
+
+// ============================================================
+// STRUCTURES
+// ============================================================
+
+// Called with each new result (from whatever context polls)
+typedef void (*FreqCounterCallback)(float frequency_hz, void* user_data);
+
+typedef struct {
+    fc_hw_t* hw;             // FC0 registers (or the mock)
+    uint32_t src;            // Clock source to measure
+    uint32_t ref_khz;        // Reference clock (kHz)
+    uint32_t interval;       // Current measurement interval (adapts)
+    bool measuring;          // A measurement is in flight
+
+    // Latest-value slot: the raw result register is one 32-bit word,
+    // so a reader always sees a whole value without any lock
+    volatile uint32_t latest_result;   // kHz with 5 fraction bits (0 = none yet)
+    volatile uint32_t sequence;        // Bumped after each new result
+
+    FreqCounterCallback callback;      // Optional (NULL = none)
+    void* user_data;
+} FreqCounter;
+
+// ============================================================
+// FUNCTION DECLARATIONS
+// ============================================================
+
+// Set up the service (no measurement starts until the first poll)
+// hw: &clocks_hw->fc0 on the device, a mock on the host
+// src: CLOCKS_FC0_SRC_VALUE_... of the clock to measure
+// ref_khz: Frequency of the counter's reference clock (kHz)
+void freq_counter_init(FreqCounter* counter, fc_hw_t* hw, uint32_t src, uint32_t ref_khz);
+
+// Call a function with every new result (NULL to stop)
+void freq_counter_set_callback(FreqCounter* counter, FreqCounterCallback callback,
+                               void* user_data);
+
+// Non-blocking: collect a finished measurement, adapt the interval and
+// start the next one. Never waits.
+// Returns: true if a new result was published
+bool freq_counter_poll(FreqCounter* counter);
+
+// Latest published frequency (Hz), 0 before the first result
+float freq_counter_latest(const FreqCounter* counter);
+
+#endif // FREQ_COUNTER_H
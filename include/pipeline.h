@@ -0,0 +1,102 @@
+// pipeline.h
+// Header file for the dual-core pipeline plumbing
+// Core 1 (control) captures the antennas, runs auto-tune and the UI;
+// core 0 (audio) renders blocks. Besides the control ring (control.h)
+// and the audio ring (audio_ring.h), the cores share:
+//   - Parameter snapshots: the control core publishes a whole
+//     AudioParams at once; the audio core picks up the newest one at
+//     the start of a block (triple buffer: lock-free and wait-free for
+//     both sides, a reader never sees half an update)
+//   - The inter-core FIFO: small messages (startup handshake, per-block
+//     stats for the UI)
+//
+// On the host (tests, load tests; built with -DHOST_TEST), core 1 is a
+// pthread and the FIFO is a pair of small queues with the hardware's
+// depth.
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "waveform.h"
+
+// ============================================================
+// CONSTANTS
+// ============================================================
+
+#define PIPELINE_AUDIO_CORE 0
+#define PIPELINE_CONTROL_CORE 1
+
+#define PIPELINE_FIFO_DEPTH 4       // Words per direction (RP2350 SIO FIFO)
+
+// FIFO messages: type in the top 8 bits, payload in the low 24
+#define PIPELINE_MSG(type, payload) (((uint32_t)(type) << 24) | ((uint32_t)(payload) & 0x00FFFFFFu))
+#define PIPELINE_MSG_TYPE(message) ((message) >> 24)
+#define PIPELINE_MSG_PAYLOAD(message) ((message) & 0x00FFFFFFu)
+
+// Message types
+#define PIPELINE_MSG_READY 1        // Control core is running (payload 0)
+#define PIPELINE_MSG_BLOCK 2        // Audio core rendered a block (payload: render time, us)
+
+#define PIPELINE_SNAPSHOT_FRESH 0x80000000u   // Middle slot holds a new snapshot
+
+// ============================================================
+// STRUCTURES
+// ============================================================
+
+// Parameters the audio core renders with (set by the control core / UI)
+typedef struct {
+    uint8_t profile;                 // Sound profile (0 = auto-tune, ...)
+    WaveformType waveform;
+    InterpolationMode interpolation;
+    q15_t gain;                      // Output level (Q15_ONE = full scale)
+} AudioParams;
+
+// Triple buffer of AudioParams
+// The writer owns slots[back], the reader owns slots[front], and the
+// third is exchanged through middle with one atomic swap per side
+typedef struct {
+    AudioParams slots[3];
+    uint32_t back;                   // Writer only
+    uint32_t front;                  // Reader only
+    volatile uint32_t middle;        // Slot index | PIPELINE_SNAPSHOT_FRESH
+} ParamSnapshots;
+
+// ============================================================
+// FUNCTION DECLARATIONS
+// ============================================================
+
+// Start with every slot = initial
+void snapshot_init(ParamSnapshots* snapshots, const AudioParams* initial);
+
+// Writer side: publish a complete new set of parameters
+void snapshot_publish(ParamSnapshots* snapshots, const AudioParams* params);
+
+// Reader side: the newest published parameters (stays valid, and
+// unchanged, until the reader's next call)
+const AudioParams* snapshot_latest(ParamSnapshots* snapshots);
+
+// Start the control core running entry (device: multicore_launch_core1)
+void pipeline_launch_control_core(void (*entry)(void));
+
+// Core the caller runs on (PIPELINE_AUDIO_CORE or PIPELINE_CONTROL_CORE)
+uint32_t pipeline_core_num(void);
+
+// Send a message to the other core
+// Returns: false (message not sent) if the FIFO is full
+bool pipeline_fifo_push(uint32_t message);
+void pipeline_fifo_push_blocking(uint32_t message);
+
+// Receive a message from the other core
+// Returns: false if there is none
+bool pipeline_fifo_pop(uint32_t* message);
+uint32_t pipeline_fifo_pop_blocking(void);
+
+#if defined(HOST_TEST)
+// Host: wait for the control core's entry function to return
+void pipeline_join_control_core(void);
+#endif
+
+#endif // PIPELINE_H
@@ -0,0 +1,124 @@
+// pwm_stream.h
+// Header file for DMA-driven, double-buffered PWM audio output
+// A DMA pacing timer triggers one transfer per audio sample; two
+// chained DMA channels ping-pong between the two halves of a buffer of
+// PWM compare values, writing each into the slice's compare register.
+// The CPU is interrupted once per block (not once per sample), when a
+// half has drained and can be refilled.
+//
+// On the host (unit tests, built with -DHOST_TEST), the same API is
+// backed by a stand-in that drains the blocks on demand and records
+// every value the DMA would have written, so tests can check the output
+// stream is gapless. Anything else (the device build) gets the DMA path.
+
+#ifndef PWM_STREAM_H
+#define PWM_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "noise_shaper.h"
+
+// ============================================================
+// CONSTANTS
+// ============================================================
+
+#define PWM_STREAM_BLOCK_BITS 8                            // 256 samples per block
+#define PWM_STREAM_BLOCK_SIZE (1 << PWM_STREAM_BLOCK_BITS)
+#define PWM_STREAM_BLOCK_BYTES (PWM_STREAM_BLOCK_SIZE * sizeof(uint16_t))
+#define PWM_STREAM_BLOCKS 2                                // One per DMA channel
+
+// ============================================================
+// STRUCTURES
+// ============================================================
+
+// Fills a block of samples (-32768..32767); called from the DMA
+// completion interrupt when set (see pwm_stream_set_fill())
+typedef void (*PwmStreamFill)(int16_t* samples, size_t count, void* user_data);
+
+// Each stream owns its buffer and fill scratch, so several can run at
+// once (each with its own slice, pacing timer and DMA channels). The
+// buffer's alignment makes the whole struct that aligned: declare
+// streams statically or on the stack, not with malloc().
+typedef struct {
+    // Both blocks back to back. Each DMA channel wraps its read address
+    // inside its own block (ring mode), which needs the block aligned to
+    // its size; aligning the pair to twice that covers both.
+    uint16_t buffer[PWM_STREAM_BLOCKS * PWM_STREAM_BLOCK_SIZE]
+        __attribute__((aligned(PWM_STREAM_BLOCKS * PWM_STREAM_BLOCK_BYTES)));
+
+    // Scratch for the fill callback's samples (the interrupt converts them)
+    int16_t fill_samples[PWM_STREAM_BLOCK_SIZE];
+
+    uint16_t* blocks[PWM_STREAM_BLOCKS];   // Compare values, one half each
+    int dma_channel[PWM_STREAM_BLOCKS];    // Channel draining each half
+    int dma_timer;                         // Pacing timer (-1 = none)
+    uint32_t slice;                        // PWM slice driven
+    uint16_t top;                          // PWM wrap value (levels 0..top)
+    float sample_rate_hz;                  // Actual rate of the pacing timer
+    NoiseShaper shaper;                    // Samples → levels (NOISE_SHAPE_NONE: truncate)
+
+    // Written by the completion interrupt, read by the writer
+    volatile int playing;                  // Block being drained (-1 = stopped)
+    volatile bool filled[PWM_STREAM_BLOCKS];  // Holds samples not yet played
+    volatile uint32_t blocks_played;
+    volatile uint32_t underruns;           // Blocks replayed because nobody refilled them
+
+    PwmStreamFill fill;                    // Optional (NULL = use pwm_stream_write_block())
+    void* user_data;
+
+    // Host stand-in only: the DMA's read position and the recording
+    size_t read_position;                  // Next value in the playing block
+    uint16_t* recording;                   // Every value "written" to the PWM
+    size_t recording_capacity;
+    size_t recorded;
+} PwmStream;
+
+// ============================================================
+// FUNCTION DECLARATIONS
+// ============================================================
+
+// Set up the PWM slice, the pacing timer and both DMA channels (does
+// not start them). Both blocks start out as silence (mid-level).
+// pin: GPIO with the PWM output
+// top: PWM wrap value; the carrier is clk_sys / (top + 1)
+// sample_rate_hz: Samples per second (the pacing timer gets as close
+// as a 16-bit fraction of clk_sys allows; see sample_rate_hz)
+void pwm_stream_init(PwmStream* stream, uint32_t pin, uint16_t top, float sample_rate_hz);
+
+// Refill drained blocks from the completion interrupt (NULL to stop)
+void pwm_stream_set_fill(PwmStream* stream, PwmStreamFill fill, void* user_data);
+
+// Requantize samples to levels with noise shaping of the given order
+// (from the next block converted; NOISE_SHAPE_NONE after init)
+void pwm_stream_set_noise_shaping(PwmStream* stream, NoiseShapeOrder order);
+
+// Start / stop the output (block 0 plays first; with a fill callback,
+// start fills any block not written yet)
+void pwm_stream_start(PwmStream* stream);
+void pwm_stream_stop(PwmStream* stream);
+
+// True if a block can be written without waiting
+bool pwm_stream_ready(const PwmStream* stream);
+
+// Convert PWM_STREAM_BLOCK_SIZE samples to compare values in the next
+// block to play. Call before start to prime both blocks.
+// Returns: false (and writes nothing) if both blocks are still queued
+bool pwm_stream_write_block(PwmStream* stream, const int16_t* samples);
+
+// Best pacing-timer fraction numerator / denominator of clock_hz for
+// sample_rate_hz (the DMA timer fires at clock_hz × X / Y)
+// Returns: the rate the fraction actually gives
+float pwm_stream_pacing_fraction(uint32_t clock_hz, float sample_rate_hz,
+                                 uint16_t* numerator, uint16_t* denominator);
+
+#if defined(HOST_TEST)
+// Host stand-in: record every compare value the DMA writes from now on
+void pwm_stream_record(PwmStream* stream, uint16_t* buffer, size_t capacity);
+
+// Host stand-in: let the DMA write count values (running the completion
+// interrupt at each block boundary, as the hardware would)
+void pwm_stream_drain(PwmStream* stream, size_t count);
+#endif
+
+#endif // PWM_STREAM_H
@@ -0,0 +1,88 @@
+// resampler.h
+// Header file for the polyphase sample-rate converter
+// Converts blocks of Q15 audio between any two rates (e.g. 44.1 kHz
+// synthesis → 20 kHz PWM output) with a Kaiser-windowed sinc FIR split
+// into phases. The output time steps through the input in 32.32 fixed
+// point; each output is the lerp of the two nearest of 2^phase_bits
+// stored phases, so any ratio works from a table of fixed size.
+//
+// All per-sample work is integer; the table is built once at init.
+
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================
+// CONSTANTS
+// ============================================================
+
+#define RESAMPLER_MAX_TAPS 96           // Taps per phase (HIGH down to 1/3 the rate)
+#define RESAMPLER_MAX_PHASE_BITS 6      // 64 phases (HIGH)
+#define RESAMPLER_MAX_PHASES (1 << RESAMPLER_MAX_PHASE_BITS)
+#define RESAMPLER_MAX_BLOCK 256         // Input samples per internal pass (AUDIO_BUFFER_SIZE)
+
+// ============================================================
+// QUALITY PRESETS
+// ============================================================
+
+// Trade CPU for stopband rejection and passband width. Filter length
+// is counted in samples of the lower of the two rates, so the taps per
+// output grow with the downsampling ratio (44.1k → 20k: ×2.2)
+// (see resampler.c for the exact filter of each)
+typedef enum {
+    RESAMPLER_FAST = 0,     // 16 samples, 16 phases
+    RESAMPLER_MEDIUM = 1,   // 24 samples, 32 phases
+    RESAMPLER_HIGH = 2      // 40 samples, 64 phases
+} ResamplerQuality;
+
+// ============================================================
+// STRUCTURES
+// ============================================================
+
+typedef struct {
+    // Filter (built by resampler_init())
+    int16_t coefficients[RESAMPLER_MAX_PHASES + 1][RESAMPLER_MAX_TAPS];  // Q15, phase × tap
+    uint32_t taps;           // Taps per phase (even)
+    uint32_t phase_bits;     // log2(phases)
+
+    // Output time step, in input samples (32.32)
+    uint32_t step_int;
+    uint32_t step_frac;
+
+    // Input history: the samples still under the filter, then the
+    // current block
+    int16_t history[RESAMPLER_MAX_TAPS + RESAMPLER_MAX_BLOCK];
+    uint32_t filled;         // Samples in history[]
+    uint32_t position;       // Output time, integer part (index in history[])
+    uint32_t fraction;       // Output time, fractional part (Q32)
+} Resampler;
+
+// ============================================================
+// FUNCTION DECLARATIONS
+// ============================================================
+
+// Set up a converter from input_rate to output_rate (Hz)
+// The filter cuts off below the lower of the two Nyquist frequencies,
+// so downsampling doesn't alias and upsampling doesn't image. Ratios
+// that would need more than RESAMPLER_MAX_TAPS get a shorter filter
+// (wider transition band).
+void resampler_init(Resampler* resampler, float input_rate, float output_rate,
+                    ResamplerQuality quality);
+
+// Clear the history (start from silence) without rebuilding the filter
+void resampler_reset(Resampler* resampler);
+
+// Convert a block: all n_in samples are consumed
+// Output k of the stream is the input signal at input time
+// k × input_rate / output_rate (zero phase; the last taps / 2 input
+// samples are only used once the next block arrives)
+// out: room for max_out samples; n_in × output_rate / input_rate + 1
+// is always enough (outputs beyond max_out are dropped)
+// Returns: number of samples written
+size_t resampler_process(Resampler* resampler, const int16_t* in, size_t n_in,
+                         int16_t* out, size_t max_out);
+
+#endif // RESAMPLER_H
@@ -0,0 +1,107 @@
+// tuning.h
+// Header file for microtonal tuning support
+// Loads Scala scale (.scl) and keyboard mapping (.kbm) files into a
+// sorted note table that auto-tune can snap to
+
+#ifndef TUNING_H
+#define TUNING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================
+// CONSTANTS
+// ============================================================
+
+#define MAX_SCALA_DEGREES 128     // Most pitches in one .scl period
+#define MAX_TUNING_NOTES 128      // Most notes in a built tuning (one per MIDI key)
+#define KBM_UNMAPPED -1           // 'x' entry in a .kbm mapping
+
+// ============================================================
+// SCALA STRUCTURES
+// ============================================================
+
+// A parsed .scl file: one period of the scale as frequency ratios
+// Degree 0 is always 1/1 and is not stored; ratios[count - 1] is the
+// period (usually 2/1, the octave)
+typedef struct {
+    char description[64];
+    int count;                        // Number of degrees in the period
+    float ratios[MAX_SCALA_DEGREES];  // Ratio of degree 1..count
+} ScalaScale;
+
+// A parsed .kbm file: which scale degree each MIDI key plays and
+// which key sounds at which frequency
+typedef struct {
+    int map_size;            // Keys per mapping repeat (0 = linear mapping)
+    int first_note;          // Lowest MIDI key to map
+    int last_note;           // Highest MIDI key to map
+    int middle_note;         // Key that plays degree 0
+    int reference_note;      // Key tuned to reference_freq
+    float reference_freq;    // Frequency of reference_note (Hz)
+    int octave_degree;       // Scale degree of the formal octave
+    int16_t map[MAX_TUNING_NOTES];  // Degree per key (KBM_UNMAPPED = none)
+} ScalaKeymap;
+
+// ============================================================
+// TUNING (WHAT AUTO-TUNE USES)
+// ============================================================
+
+// A tuning ready for quantization: every playable note sorted by
+// frequency, plus the precomputed boundary between neighbours
+// (their geometric mean, i.e. the midpoint in cents).
+// Finding the nearest note is a binary search over bounds[], whatever
+// the scale size.
+typedef struct {
+    int count;                          // Number of notes
+    float freqs[MAX_TUNING_NOTES];      // Note frequencies, ascending (Hz)
+    float pitches[MAX_TUNING_NOTES];    // Same notes in semitones from A4
+    float bounds[MAX_TUNING_NOTES];     // bounds[i] = boundary between
+                                        // notes i and i+1
+    uint32_t generation;                // Changes on every rebuild
+} Tuning;
+
+// Just intonation (5-limit, 12 notes) as an in-flash .scl blob
+// On the device, tunings come from blobs like this one
+extern const char tuning_just_intonation_scl[];
+
+// ============================================================
+// FUNCTION DECLARATIONS
+// ============================================================
+
+// Parse a .scl file held in memory (flash blob or file contents)
+// Returns: true on success
+bool tuning_parse_scl(ScalaScale* scale, const char* text, size_t length);
+
+// Parse a .kbm file held in memory
+// Returns: true on success
+bool tuning_parse_kbm(ScalaKeymap* keymap, const char* text, size_t length);
+
+// Default keyboard mapping: linear, degree 0 on MIDI 60, MIDI 69 = 440 Hz
+void tuning_default_keymap(ScalaKeymap* keymap);
+
+// Build the sorted note table for a scale and mapping
+// keymap: NULL = tuning_default_keymap()
+// min_freq, max_freq: Range of notes to keep (Hz)
+// Returns: false (tuning left unchanged) if no note is in range
+bool tuning_build(Tuning* tuning, const ScalaScale* scale, const ScalaKeymap* keymap,
+                  float min_freq, float max_freq);
+
+// Find the note of a tuning nearest (in cents) to a frequency
+// tuning: built by tuning_build() (at least one note)
+// Returns: index into tuning->freqs, or 0 if the tuning has no notes
+// (count == 0: never built, so there is no freqs[0] to use)
+int tuning_nearest_index(const Tuning* tuning, float freq);
+
+// Same, returning the note's frequency (Hz)
+// Returns: freq unchanged if the tuning has no notes
+float tuning_nearest(const Tuning* tuning, float freq);
+
+#if defined(HOST_TEST)
+// Host only: read and parse .scl / .kbm files from disk
+bool tuning_load_scl_file(ScalaScale* scale, const char* path);
+bool tuning_load_kbm_file(ScalaKeymap* keymap, const char* path);
+#endif
+
+#endif // TUNING_H
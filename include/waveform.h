@@ -6,6 +6,7 @@
 #define WAVEFORM_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 // ============================================================
 // CONSTANTS
@@ -15,6 +16,25 @@
 #define SAMPLE_RATE 44100         // Audio sample rate (Hz)
 #define PHASE_SCALE 4294967296.0f // 2^32 for phase accumulator
 
+// Q15 fixed point: int16 where 32767 = +1.0
+// Used for the wavetables, the integer render path and gains
+typedef int16_t q15_t;
+#define Q15_ONE 32767
+#define Q15_TO_FLOAT (1.0f / 32767.0f)
+
+// Phase accumulator layout (32 bits):
+//   [31..24] table index (0-255)   [23..8] Q16 fraction   [7..0] unused
+#define WAVETABLE_MASK (WAVETABLE_SIZE - 1)
+#define PHASE_INDEX_SHIFT 24      // Top 8 bits select the table entry
+#define PHASE_FRAC_SHIFT 8        // Next 16 bits are the Q16 fraction
+
+// Band-limited mipmaps (square and sawtooth)
+// Level k holds harmonics 1..(128 >> k), which stay below Nyquist for any
+// phase_increment < 2^(24 + k). Level 0 covers up to ~172 Hz, each level
+// after that one octave more, and level 7 is a pure sine.
+#define MIPMAP_LEVELS 8
+#define MIPMAP_BASE_SHIFT 24      // log2 of the phase_increment limit of level 0
+
 // ============================================================
 // WAVEFORM TYPES
 // ============================================================
@@ -23,9 +43,28 @@ typedef enum {
     WAVEFORM_SINE = 0,      // Smooth, pure tone
     WAVEFORM_SQUARE = 1,    // Hollow, buzzy (odd harmonics)
     WAVEFORM_SAWTOOTH = 2,  // Bright, rich (all harmonics)
-    WAVEFORM_TRIANGLE = 3   // Mellow, warm (weak odd harmonics)
+    WAVEFORM_TRIANGLE = 3,  // Mellow, warm (weak odd harmonics)
+    
+    // Analytic versions: computed from the phase accumulator with
+    // PolyBLEP/PolyBLAMP corrections at the edges instead of a table.
+    // No table memory, alias-suppressed at any pitch (even during fast
+    // glides), ignores the interpolation mode.
+    WAVEFORM_SQUARE_BLEP = 4,
+    WAVEFORM_SAWTOOTH_BLEP = 5,
+    WAVEFORM_TRIANGLE_BLEP = 6
 } WaveformType;
 
+// ============================================================
+// INTERPOLATION MODES
+// ============================================================
+
+// How the fractional phase bits between two table entries are used
+typedef enum {
+    INTERP_NONE = 0,        // Truncate to table entry (cheapest, stair-steps)
+    INTERP_LINEAR = 1,      // 2-point linear between neighbours
+    INTERP_HERMITE = 2      // 4-point, 3rd-order Hermite (smoothest)
+} InterpolationMode;
+
 // ============================================================
 // OSCILLATOR STRUCTURE
 // ============================================================
@@ -35,6 +74,7 @@ typedef struct {
     uint32_t phase;          // Current position in the waveform (0 to 2^32)
     uint32_t phase_increment; // How much to advance phase each sample
     WaveformType waveform_type; // Which waveform to generate
+    InterpolationMode interpolation; // How to read between table entries
 } Oscillator;
 
 // ============================================================
@@ -42,17 +82,36 @@ typedef struct {
 // ============================================================
 
 // Pre-calculated waveform tables for fast lookup
-// Each table has 256 samples representing one complete cycle
-extern float sine_table[WAVETABLE_SIZE];
-extern float square_table[WAVETABLE_SIZE];
-extern float sawtooth_table[WAVETABLE_SIZE];
-extern float triangle_table[WAVETABLE_SIZE];
+// Each table has 256 samples representing one complete cycle, stored as
+// Q15 integers (-32767 to +32767 = -1.0 to +1.0). The integer render path
+// uses them directly, the float path scales by Q15_TO_FLOAT.
+//
+// The tables are generated at build time by tools/gen_wavetables.py into
+// src/wavetables.c, so nothing is computed at boot. By default they stay
+// in flash; build with -DWAVETABLES_IN_RAM to have them copied to SRAM
+// (no XIP cache misses in the render loop).
+#if defined(WAVETABLES_IN_RAM)
+#include "pico/platform.h"
+#define WAVETABLE_SECTION __not_in_flash("wavetables")
+#else
+#define WAVETABLE_SECTION
+#endif
+
+extern const int16_t sine_table[WAVETABLE_SIZE];
+extern const int16_t triangle_table[WAVETABLE_SIZE];
+
+// Square and sawtooth are band-limited, one table per octave
+// [level][sample], see MIPMAP_LEVELS above
+extern const int16_t square_table[MIPMAP_LEVELS][WAVETABLE_SIZE];
+extern const int16_t sawtooth_table[MIPMAP_LEVELS][WAVETABLE_SIZE];
 
 // ============================================================
 // FUNCTION DECLARATIONS
 // ============================================================
 
 // Initialize waveform system (call once at startup)
+// The tables are const and generated at build time, so this does no work
+// any more; kept so existing startup code does not change
 void waveform_init(void);
 
 // Initialize an oscillator
@@ -63,12 +122,41 @@ void oscillator_init(Oscillator* osc, WaveformType type);
 // frequency: Desired frequency in Hz
 void oscillator_set_frequency(Oscillator* osc, float frequency);
 
+// Same, for an oscillator clocked at a rate other than SAMPLE_RATE
+// (e.g. the PWM output interrupt)
+void oscillator_set_frequency_rate(Oscillator* osc, float frequency, uint32_t sample_rate);
+
 // Set the waveform type of an oscillator
 void oscillator_set_waveform(Oscillator* osc, WaveformType type);
 
+// Set the wavetable interpolation mode of an oscillator
+void oscillator_set_interpolation(Oscillator* osc, InterpolationMode mode);
+
+// Pick the band-limited mipmap level for a phase increment
+// Returns: 0 (all harmonics) to MIPMAP_LEVELS - 1 (fundamental only)
+int waveform_mipmap_level(uint32_t phase_increment);
+
 // Generate one audio sample from the oscillator
 // osc: Pointer to the oscillator
 // Returns: Audio sample value (-1.0 to +1.0)
 float oscillator_generate_sample(Oscillator* osc);
 
+// Generate one Q15 audio sample (-32767 to +32767), no float on the
+// table path
+q15_t oscillator_generate_sample_q15(Oscillator* osc);
+
+// Render a whole block of samples from the oscillator
+// The waveform table is chosen once per block, then a tight loop
+// fills the buffer (much cheaper than calling generate_sample n times)
+// osc: Pointer to the oscillator
+// out: Output buffer (-1.0 to +1.0 for float, -32767 to +32767 for int16)
+// n: Number of samples to render
+void oscillator_render_block(Oscillator* osc, float* out, size_t n);
+void oscillator_render_block_int16(Oscillator* osc, int16_t* out, size_t n);
+
+// Integer render path: Q15 tables -> Q15 interpolation -> Q15 gain,
+// written straight into an int16 buffer (e.g. audio_buffer)
+// gain: Output level in Q15 (Q15_ONE = full scale)
+void oscillator_render_block_q15(Oscillator* osc, q15_t* out, size_t n, q15_t gain);
+
 #endif // WAVEFORM_H
\ No newline at end of file
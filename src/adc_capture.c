@@ -0,0 +1,229 @@
+// adc_capture.c
+// Implementation of the free-running DMA ADC capture
+// (and its host stand-in for unit tests)
+
+#include "../include/adc_capture.h"
+
+#if !defined(HOST_TEST)
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include "pico/stdlib.h"
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+// ============================================================
+// SHARED: BLOCK HAND-OUT
+// ============================================================
+
+// The capture that owns the ADC (NULL = none running)
+static AdcCapture* running_capture = NULL;
+
+static bool claim_adc(AdcCapture* capture) {
+    if (running_capture != NULL && running_capture != capture) {
+        return false;   // One ADC: the other capture has it
+    }
+    running_capture = capture;
+    return true;
+}
+
+static void release_adc(AdcCapture* capture) {
+    if (running_capture == capture) {
+        running_capture = NULL;
+    }
+}
+
+static const uint16_t* acquire_completed(AdcCapture* capture, int writing_block) {
+    // With two blocks, the one not being written is the newest complete
+    // one - except before the first block has finished.
+    if (writing_block < 0) {
+        return NULL;   // Stopped (or between the two channels)
+    }
+
+    int complete = writing_block ^ 1;
+    if (complete == capture->last_block) {
+        return NULL;   // Already handed out
+    }
+    if (capture->last_block < 0 && complete == 1) {
+        return NULL;   // Still filling block 0 for the first time
+    }
+
+    capture->last_block = complete;
+    capture->blocks_acquired++;
+    return capture->blocks[complete];
+}
+
+static void init_blocks(AdcCapture* capture, uint8_t adc_channel, float sample_rate_hz) {
+    capture->adc_channel = adc_channel;
+    capture->sample_rate_hz = sample_rate_hz;
+    for (int i = 0; i < ADC_CAPTURE_BLOCKS; i++) {
+        capture->blocks[i] = &capture->buffer[i * ADC_CAPTURE_BLOCK_SIZE];
+        capture->dma_channel[i] = -1;
+    }
+    capture->last_block = -1;
+    capture->blocks_acquired = 0;
+    capture->writing_block = -1;
+    capture->write_position = 0;
+}
+
+#if !defined(HOST_TEST)
+
+// ============================================================
+// DEVICE: ADC + CHAINED DMA
+// ============================================================
+
+void adc_capture_init(AdcCapture* capture, uint8_t adc_channel, float sample_rate_hz) {
+    init_blocks(capture, adc_channel, sample_rate_hz);
+
+    // STEP 1: The input pin (the ADC itself is set up when started)
+    adc_gpio_init(ADC_BASE_PIN + adc_channel);   // GPIO 26+ (RP2350A) or 40+ (RP2350B)
+
+    // STEP 2: Two channels, each filling one block and then starting
+    // the other. The write ring wraps each channel back to the start of
+    // its block, and the transfer count reloads on every trigger, so the
+    // ping-pong runs forever with no interrupt and no reprogramming.
+    capture->dma_channel[0] = dma_claim_unused_channel(true);
+    capture->dma_channel[1] = dma_claim_unused_channel(true);
+
+    for (int i = 0; i < ADC_CAPTURE_BLOCKS; i++) {
+        int channel = capture->dma_channel[i];
+        int partner = capture->dma_channel[i ^ 1];
+
+        dma_channel_config config = dma_channel_get_default_config(channel);
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+        channel_config_set_read_increment(&config, false);   // Always the FIFO
+        channel_config_set_write_increment(&config, true);
+        channel_config_set_ring(&config, true, ADC_CAPTURE_BLOCK_BITS + 1);  // Wrap in block (bytes)
+        channel_config_set_dreq(&config, DREQ_ADC);
+        channel_config_set_chain_to(&config, partner);
+
+        dma_channel_configure(channel, &config,
+                              capture->blocks[i],      // Write: this block
+                              &adc_hw->fifo,           // Read: ADC FIFO
+                              ADC_CAPTURE_BLOCK_SIZE,  // One block per trigger
+                              false);                  // Don't start yet
+    }
+}
+
+bool adc_capture_start(AdcCapture* capture) {
+    if (!claim_adc(capture)) {
+        return false;
+    }
+
+    // STEP 1: ADC free-running into its FIFO, one DREQ per conversion
+    adc_init();
+    adc_select_input(capture->adc_channel);
+    adc_fifo_setup(true,    // Write conversions to the FIFO
+                   true,    // DREQ when a sample is ready
+                   1,       // ... as soon as there is one
+                   false,   // No error bit in the sample
+                   false);  // Keep all 12 bits
+
+    // Conversions take 96 ADC clocks at minimum; clkdiv spaces them
+    // out to the requested rate (48 MHz ADC clock)
+    float divider = (float)clock_get_hz(clk_adc) / capture->sample_rate_hz - 1.0f;
+    adc_set_clkdiv(divider < 0.0f ? 0.0f : divider);
+
+    // STEP 2: Block 0 first; the chain takes it from there
+    capture->last_block = -1;
+    adc_fifo_drain();
+    dma_channel_start(capture->dma_channel[0]);
+    adc_run(true);
+    return true;
+}
+
+void adc_capture_stop(AdcCapture* capture) {
+    if (running_capture != capture) {
+        return;   // Not running: the ADC belongs to another capture
+    }
+
+    // Abort both at once, so the chain can't restart the one just aborted
+    uint32_t mask = (1u << capture->dma_channel[0]) | (1u << capture->dma_channel[1]);
+    adc_run(false);
+    dma_hw->abort = mask;
+    while (dma_hw->abort & mask) {
+        tight_loop_contents();
+    }
+    adc_fifo_drain();
+    release_adc(capture);
+}
+
+const uint16_t* adc_capture_acquire(AdcCapture* capture) {
+    // The busy channel tells which block is being written
+    bool busy0 = dma_channel_is_busy(capture->dma_channel[0]);
+    bool busy1 = dma_channel_is_busy(capture->dma_channel[1]);
+
+    int writing = (busy0 == busy1) ? -1 : (busy0 ? 0 : 1);
+    return acquire_completed(capture, writing);
+}
+
+#else
+
+// ============================================================
+// HOST STAND-IN
+// ============================================================
+
+void adc_capture_init(AdcCapture* capture, uint8_t adc_channel, float sample_rate_hz) {
+    init_blocks(capture, adc_channel, sample_rate_hz);
+}
+
+bool adc_capture_start(AdcCapture* capture) {
+    // Same one-ADC rule as the device
+    if (!claim_adc(capture)) {
+        return false;
+    }
+
+    capture->last_block = -1;
+    capture->writing_block = 0;
+    capture->write_position = 0;
+    return true;
+}
+
+void adc_capture_stop(AdcCapture* capture) {
+    if (running_capture != capture) {
+        return;
+    }
+    capture->writing_block = -1;
+    release_adc(capture);
+}
+
+const uint16_t* adc_capture_acquire(AdcCapture* capture) {
+    return acquire_completed(capture, capture->writing_block);
+}
+
+void adc_capture_feed(AdcCapture* capture, const uint16_t* samples, size_t count) {
+    // What the two chained DMA channels do, one sample at a time
+    if (capture->writing_block < 0) {
+        return;   // Stopped: the ADC isn't running
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        capture->blocks[capture->writing_block][capture->write_position++] = samples[i];
+
+        // Block full: the chain starts the other channel
+        if (capture->write_position == ADC_CAPTURE_BLOCK_SIZE) {
+            capture->write_position = 0;
+            capture->writing_block ^= 1;
+        }
+    }
+}
+
+size_t adc_capture_read_trace(const char* path, uint16_t* samples, size_t max_samples) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return 0;
+    }
+
+    size_t count = 0;
+    unsigned int value;
+    while (count < max_samples && fscanf(file, "%u", &value) == 1) {
+        samples[count++] = (uint16_t)(value & 0x0FFF);   // 12-bit ADC
+    }
+
+    fclose(file);
+    return count;
+}
+
+#endif
@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include "pico/stdlib.h"
 #include "hardware/pwm.h"
+#include "../include/waveform.h"
+#include "../include/pwm_stream.h"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -11,6 +13,7 @@
 
 // Constants
 const int PWM_PIN = 37;
+const uint16_t PWM_TOP = 2047; // 11-bit levels, ~73 kHz carrier at 150 MHz
 const int M_PI = 3.14159;
 
 const int VOL_PINS[4] = {28,29,30,31}; // B0..B3
@@ -18,24 +21,19 @@ const int SOUND_PINS[4] = {15,16,17,18}; // PLACEHOLDER VALUES
 const int ON_PIN = 26; // PLACEHOLDER VALUE
 
 int profile = 0; // default uses sine wave
-int step0 = 0;
-int offset0 = 0;
-int step1 = 0;
-int offset1 = 0;
+Oscillator voice0; // channel 0, shares the Q15 tables with sound_profiles.c
+Oscillator voice1; // channel 1
 int volume = 2400;
 int rate = 20000;
 static int duty_cycle = 0;
-
-#define M_PI		3.14159265358979323846
-#define N 1000
-extern int wavetable[N];
+static PwmStream audio_stream; // DMA feeds the PWM; one IRQ per block, not per sample
 
 void init_gpio();
 void updated_gpio_handler();
 void pwm_reset();
 void init_wavetable(int profile_num);
 void set_freq(int chan, float f);
-void pwm_audio_handler();
+void pwm_audio_fill(int16_t* samples, size_t count, void* user_data);
 void init_pwm_audio();
 
 //////////////////////////////////////////////////////////////////////////////
@@ -66,35 +64,31 @@ void init_gpio_irq() {
 
 void init_wavetable(int profile_num) {
     // triangle square sine
-    for(int i=0; i < N; i++)
-        wavetable[i] = (16383 * sin(2 * M_PI * i / N)) + 16384;
+    // tables live in waveform.c (Q15, shared with the synth)
+    waveform_init();
+    oscillator_init(&voice0, WAVEFORM_SINE);
+    oscillator_init(&voice1, WAVEFORM_SINE);
+    oscillator_set_interpolation(&voice0, INTERP_LINEAR);
+    oscillator_set_interpolation(&voice1, INTERP_LINEAR);
 }
 
 void set_freq(int chan, float f) {
-    if (chan == 0) {
-        if (f == 0.0) {
-            step0 = 0;
-            offset0 = 0;
-        } else
-            step0 = (f * N / rate) * (1<<16);
-    }
-    if (chan == 1) {
-        if (f == 0.0) {
-            step1 = 0;
-            offset1 = 0;
-        } else
-            step1 = (f * N / rate) * (1<<16);
-    }
+    if (chan != 0 && chan != 1) return;
+    Oscillator* voice = (chan == 0) ? &voice0 : &voice1;
+
+    if (f == 0.0) {
+        voice -> phase_increment = 0;
+        voice -> phase = 0;
+    } else
+        oscillator_set_frequency_rate(voice, f, rate);
 }
 
-int create_sine_samp(uint slice_num) {
-    offset0 = offset0 + step0;
-    offset1 = offset1 + step1;
-    if (offset0 >= (N << 16)) offset0 = offset0 - (N << 16);
-    if (offset1 >= (N << 16)) offset1 = offset1 - (N << 16);
-    int samp = wavetable[offset0 >> 16] + wavetable[offset1 >> 16];
+int create_sine_samp() {
+    // mix the two voices in Q15 (-32767..32767), all integer
+    int samp = oscillator_generate_sample_q15(&voice0) + oscillator_generate_sample_q15(&voice1);
+    samp = samp / 2;
+    // same level as before: half scale (pwm_stream maps it onto 0..top)
     samp = samp / 2;
-    samp = samp * (pwm_hw -> slice[slice_num].top) / (1 << 16);
 
     // if proofile = delay, delay()
     // delayed_by_us();
@@ -106,30 +100,27 @@ int create_sine_samp(uint slice_num) {
 
 // create_rect_samp() 
 
-void pwm_audio_handler() {
-    // fill in
-    uint slice_num = pwm_gpio_to_slice_num(PWM_PIN);
-    pwm_clear_irq(slice_num);
+void pwm_audio_fill(int16_t* samples, size_t count, void* user_data) {
+    // runs in the DMA completion IRQ, once per PWM_STREAM_BLOCK_SIZE
+    // samples: renders the next block while DMA plays the other half
+    (void)user_data;
 
     // LOGIC FOR CHOOSING WAVEFORM HERE
 
-    pwm_set_chan_level(slice_num, pwm_gpio_to_channel(PWM_PIN), samp);
+    for (size_t i = 0; i < count; i++) {
+        samples[i] = (int16_t)create_sine_samp();
+    }
 }
 
 void init_pwm_audio() {
-    // fill in
-    pwm_config c = pwm_get_default_config();
-    uint slice_num = pwm_gpio_to_slice_num(PWM_PIN);
-
-    pwm_init(slice_num, &c, true);
-    gpio_set_function(PWM_PIN, GPIO_FUNC_PWM);
-    pwm_set_clkdiv_mode(slice_num, PWM_DIV_FREE_RUNNING); // PWM output
-    // pwm_set_clkdiv(slice_num, 150); // changes pwm clock freq
-    // pwm_hw -> slice[slice_num].top = 1000000 / (rate - 1); // sets period of PWM signal to get PWM output freq (currently at 20 kHz)
-    // pwm_set_wrap(slice_num, (pwm_hw -> slice[slice_num].top) - 1); // works with line above
+    // PWM slice wraps at PWM_TOP; a DMA pacing timer writes one level
+    // per sample at `rate` (replaces the per-wrap pwm_audio_handler IRQ)
     duty_cycle = 0; // initialize duty cycle
     init_wavetable(profile); // sets up sine wave in memory
-    irq_set_exclusive_handler(PWM_DEFAULT_IRQ_NUM(), pwm_audio_handler);
-    irq_set_enabled(PWM_DEFAULT_IRQ_NUM(), true);
-    pwm_set_irq_enabled(slice_num, true);
+    pwm_stream_init(&audio_stream, PWM_PIN, PWM_TOP, (float)rate);
+    // 11 bits truncate quiet tones into harmonics; 2nd-order shaping
+    // moves the error up toward 10 kHz (~15 dB less below 2 kHz)
+    pwm_stream_set_noise_shaping(&audio_stream, NOISE_SHAPE_SECOND);
+    pwm_stream_set_fill(&audio_stream, pwm_audio_fill, NULL);
+    pwm_stream_start(&audio_stream);
 }
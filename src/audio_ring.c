@@ -0,0 +1,73 @@
+// audio_ring.c
+// Implementation of the single-producer / single-consumer audio ring
+
+#include "../include/audio_ring.h"
+
+// ============================================================
+// SETUP
+// ============================================================
+
+void audio_ring_init(AudioRing* ring) {
+    ring->head = 0;
+    ring->cached_tail = 0;
+    ring->overruns = 0;
+    ring->tail = 0;
+    ring->cached_head = 0;
+    ring->underruns = 0;
+}
+
+// ============================================================
+// PRODUCER SIDE
+// ============================================================
+
+uint32_t audio_ring_space(AudioRing* ring) {
+    // head and tail count up forever; head - tail is the fill level
+    // even after they wrap
+    uint32_t head = ring->head;
+
+    if (head - ring->cached_tail >= AUDIO_RING_BLOCKS) {
+        // Looks full from the cached copy: take a fresh look
+        ring->cached_tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    }
+    return AUDIO_RING_BLOCKS - (head - ring->cached_tail);
+}
+
+int16_t* audio_ring_acquire_write(AudioRing* ring) {
+    if (audio_ring_space(ring) == 0) {
+        ring->overruns++;
+        return NULL;
+    }
+    return ring->blocks[ring->head & AUDIO_RING_MASK];
+}
+
+void audio_ring_commit_write(AudioRing* ring) {
+    // Publish the block only after its samples are written
+    __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_RELEASE);
+}
+
+// ============================================================
+// CONSUMER SIDE
+// ============================================================
+
+uint32_t audio_ring_available(AudioRing* ring) {
+    uint32_t tail = ring->tail;
+
+    if (ring->cached_head == tail) {
+        // Looks empty from the cached copy: take a fresh look
+        ring->cached_head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    }
+    return ring->cached_head - tail;
+}
+
+const int16_t* audio_ring_acquire_read(AudioRing* ring) {
+    if (audio_ring_available(ring) == 0) {
+        ring->underruns++;
+        return NULL;
+    }
+    return ring->blocks[ring->tail & AUDIO_RING_MASK];
+}
+
+void audio_ring_release_read(AudioRing* ring) {
+    // Hand the block back only after its samples have been read
+    __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+}
@@ -2,8 +2,10 @@
 // Implementation of auto-tune functionality
 
 #include "../include/autotune.h"
+#include "../include/fastmath.h"
 #include <math.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 // ============================================================
 // GLOBAL VARIABLES
@@ -13,6 +15,7 @@
 float note_table[NUM_NOTES];
 
 // piano keys without sharps (white keys only)
+// (auto-tune snaps to these with scale_set(SCALE_MAJOR, NOTE_C))
 const float piano_keys_frequencies[38] = {
     110.0000, 123.4708, 130.8128, 146.8324,
     164.8138, 174.6141, 195.9977, 220.0000, 246.9417, 261.6256,
@@ -39,6 +42,16 @@ const float piano_keys_frequencies[38] = {
 // Auto-tune state - tracks where we are in the correction process
 AutoTuneState autotune_state;
 
+// log2 of the lowest note, so find_nearest_note() can turn a frequency
+// into a semitone number with one subtraction
+static float first_note_log2;
+
+// Scale used by process_autotune()
+Scale active_scale;
+
+// Source of Scale.generation: every build gets a new number
+static uint32_t scale_generation_counter = 0;
+
 // ============================================================
 // INITIALIZATION
 // ============================================================
@@ -55,31 +68,124 @@ void autotune_init(void) {
     
     for (int note_num = 0; note_num < NUM_NOTES; note_num++) {
         // Calculate how many semitones away from A4 this note is
-        int semitones_from_a4 = note_num - 49;
+        int semitones_from_a4 = note_num - A4_NOTE_INDEX;
         
         // Calculate the frequency using the equal temperament formula
         // 2^(semitones/12) gives us the frequency ratio
         float exponent = (float)semitones_from_a4 / 12.0f;
-        float frequency = REFERENCE_A4 * powf(2.0f, exponent);
+        float frequency = REFERENCE_A4 * exp2f(exponent);   // Exact: init only
         
         // Store in the note table
         note_table[note_num] = frequency;
     }
     
+    first_note_log2 = log2f(note_table[0]);
+    
+    // Snap to every note until a scale is chosen
+    scale_set(SCALE_CHROMATIC, NOTE_C);
+    
     // Initialize auto-tune state to neutral values
     // Start at A4 (440 Hz) - middle of our range
-    autotune_state.current_freq = REFERENCE_A4;
-    autotune_state.target_freq = REFERENCE_A4;
-    autotune_state.last_input_freq = 0.0f;
+    AutoTuneConfig config = AUTOTUNE_DEFAULT_CONFIG;
+    autotune_state_init(&autotune_state, &config);
+}
+
+static float glide_coefficient(float glide_ms, float rate_hz) {
+    // One-pole smoothing with time constant glide_ms at rate_hz:
+    //   coefficient = 1 - e^(-1 / (time constant in samples))
+    // so after glide_ms the glide has covered 63% of the way at ANY rate
+    float samples = glide_ms * 0.001f * rate_hz;
+    if (samples <= 1e-3f) {
+        return 1.0f;   // Zero time (or no rate): snap instantly
+    }
+    return 1.0f - expf(-1.0f / samples);
+}
+
+static float glide_step(float glide_ms, float rate_hz) {
+    // Timed curves cover the whole glide in glide_ms
+    float samples = glide_ms * 0.001f * rate_hz;
+    if (samples <= 1.0f) {
+        return 1.0f;   // Shorter than a sample: land at once
+    }
+    return 1.0f / samples;
+}
+
+static void update_glide(AutoTuneState* state) {
+    // Cached, so the per-sample and per-block paths need no expf (the
+    // control loop calls the block function one sample at a time)
+    state->glide_coefficient = glide_coefficient(state->glide_ms, state->rate_hz);
+    state->glide_step = glide_step(state->glide_ms, state->rate_hz);
+}
+
+void autotune_state_init(AutoTuneState* state, const AutoTuneConfig* config) {
+    // Copy the settings into the voice, then start from neutral
+    state->strength = config->strength;
+    state->glide_rate = config->glide_rate;
+    state->scale = config->scale;
+    state->glide_ms = config->glide_ms;
+    state->rate_hz = config->rate_hz;
+    state->glide_curve = config->glide_curve;
+    state->tuning = config->tuning;
+    update_glide(state);
+    reset_autotune_state(state);   // No target yet, so no zone to re-widen
+    autotune_set_vibrato(state, config->vibrato_cutoff_hz);
+    autotune_set_hysteresis(state, config->dead_zone_cents, config->min_dwell_ms);
 }
 
 // ============================================================
 // FIND NEAREST NOTE
 // ============================================================
 
+static inline float semitones_above_first_note(float freq) {
+    // Notes are 12 per octave, so semitones = 12 × log2(f / f0)
+    // Accurate to ~0.001 semitones (see fast_log2f)
+    return 12.0f * (fast_log2f(freq) - first_note_log2);
+}
+
 float find_nearest_note(float input_freq) {
     // This function finds which note in our table is closest
-    // to the input frequency
+    // to the input frequency, without scanning the table
+    
+    // Clamp input to valid range (same as the reference scan)
+    if (input_freq < FIRST_NOTE_FREQ) {
+        input_freq = FIRST_NOTE_FREQ;
+    }
+    if (input_freq > note_table[NUM_NOTES - 1]) {
+        input_freq = note_table[NUM_NOTES - 1];
+    }
+    
+    // STEP 1: Semitones above the lowest note
+    float semitones = semitones_above_first_note(input_freq);
+    
+    // STEP 2: Round to the nearest semitone and clamp to the table
+    int guess = (int)(semitones + 0.5f);
+    if (guess < 0) guess = 0;
+    if (guess > NUM_NOTES - 1) guess = NUM_NOTES - 1;
+    
+    // STEP 3: The log2 approximation is well within half a semitone, so
+    // the nearest note (in Hz, like the reference) is guess-1, guess or
+    // guess+1. Compare just those three.
+    int first = (guess > 0) ? guess - 1 : 0;
+    int last = (guess < NUM_NOTES - 1) ? guess + 1 : NUM_NOTES - 1;
+    
+    float closest_freq = note_table[first];
+    float closest_distance = fabsf(input_freq - closest_freq);
+    
+    for (int i = first + 1; i <= last; i++) {
+        float distance = fabsf(input_freq - note_table[i]);
+        if (distance < closest_distance) {
+            closest_distance = distance;
+            closest_freq = note_table[i];
+        }
+    }
+    
+    return closest_freq;
+}
+
+float find_nearest_note_reference(float input_freq) {
+    // This function finds which note in our table is closest
+    // to the input frequency by checking every one of them.
+    // Kept as the reference for find_nearest_note() in the tests.
     
     // Clamp input to valid range
     // If frequency is too low or too high, limit it to our range
@@ -115,41 +221,276 @@ float find_nearest_note(float input_freq) {
     return closest_freq;
 }
 
+// ============================================================
+// SCALES
+// ============================================================
+
+static uint16_t builtin_scale_mask(ScaleType type) {
+    switch (type) {
+        case SCALE_MAJOR:      return SCALE_MASK_MAJOR;
+        case SCALE_MINOR:      return SCALE_MASK_MINOR;
+        case SCALE_PENTATONIC: return SCALE_MASK_PENTATONIC;
+        case SCALE_BLUES:      return SCALE_MASK_BLUES;
+        default:               return SCALE_MASK_CHROMATIC;
+    }
+}
+
+void scale_build(Scale* scale, ScaleType type, uint16_t mask, uint8_t root) {
+    // Precompute, for every semitone k, the nearest allowed notes below
+    // (at or below k) and above (k+1 or higher)
+    
+    if (type != SCALE_CUSTOM) {
+        mask = builtin_scale_mask(type);
+    }
+    mask &= SCALE_MASK_CHROMATIC;
+    if (mask == 0) {
+        mask = SCALE_MASK_CHROMATIC;   // Empty scale: snap to every note
+    }
+    
+    scale->type = type;
+    scale->mask = mask;
+    scale->root = root % 12;
+    scale->generation = ++scale_generation_counter;
+    
+    // Which table entries are in the scale?
+    // Pitch class of note_table[i]: A4 (index 49) is NOTE_A
+    bool allowed[NUM_NOTES];
+    for (int i = 0; i < NUM_NOTES; i++) {
+        int pitch_class = ((i - A4_NOTE_INDEX + NOTE_A) % 12 + 12) % 12;
+        int degree = (pitch_class - scale->root + 12) % 12;
+        allowed[i] = (mask >> degree) & 1;
+    }
+    
+    // Pass 1 (upward): last allowed note at or below k
+    int last = -1;
+    for (int k = 0; k < NUM_NOTES; k++) {
+        if (allowed[k]) last = k;
+        scale->below[k] = (uint8_t)last;   // Fixed up below if still -1
+    }
+    
+    // Pass 2 (downward): first allowed note above k
+    int next = -1;
+    for (int k = NUM_NOTES - 1; k >= 0; k--) {
+        scale->above[k] = (uint8_t)((next >= 0) ? next : scale->below[k]);
+        if (allowed[k]) next = k;
+        
+        // Nothing allowed at or below k (bottom of the range)
+        if (scale->below[k] == (uint8_t)-1) {
+            scale->below[k] = scale->above[k];
+        }
+    }
+}
+
+void scale_set(ScaleType type, uint8_t root) {
+    scale_build(&active_scale, type, active_scale.mask, root);
+}
+
+void scale_set_custom(uint16_t mask, uint8_t root) {
+    scale_build(&active_scale, SCALE_CUSTOM, mask, root);
+}
+
+float quantize_to_scale(const Scale* scale, float input_freq) {
+    return note_table[quantize_to_scale_index(scale, input_freq)];
+}
+
+int quantize_to_scale_index(const Scale* scale, float input_freq) {
+    // Same clamping as find_nearest_note()
+    if (input_freq < FIRST_NOTE_FREQ) {
+        input_freq = FIRST_NOTE_FREQ;
+    }
+    if (input_freq > note_table[NUM_NOTES - 1]) {
+        input_freq = note_table[NUM_NOTES - 1];
+    }
+    
+    // STEP 1: Which semitone are we in?
+    int k = (int)semitones_above_first_note(input_freq);
+    if (k < 0) k = 0;
+    if (k > NUM_NOTES - 1) k = NUM_NOTES - 1;
+    
+    // STEP 2: One fetch gives the two candidate notes, pick the closer
+    // If the log2 error put k one semitone off, the candidates are
+    // still the same two allowed notes, or k itself is allowed and wins
+    int below = scale->below[k];
+    int above = scale->above[k];
+    
+    return (fabsf(input_freq - note_table[above]) < fabsf(input_freq - note_table[below]))
+        ? above : below;
+}
+
 // ============================================================
 // PROCESS AUTO-TUNE
 // ============================================================
 
-float process_autotune(float input_freq, float strength, float glide_rate) {
-    // This is the main auto-tune processing function
-    // It takes raw frequency and returns corrected frequency
+static void set_stay_zone(AutoTuneState* state, const Scale* scale, int note) {
+    // The boundary to a neighbouring note is their geometric mean (the
+    // midpoint in cents); the zone reaches dead_zone_cents past it.
+    // No neighbour on a side = the zone is open on that side.
+    float freq = note_table[note];
+    int up = scale->above[note];
+    int down = (note > 0) ? scale->below[note - 1] : note;
+    
+    state->zone_high = (up > note)
+        ? sqrtf(freq * note_table[up]) * state->dead_zone_ratio
+        : INFINITY;
+    state->zone_low = (down < note)
+        ? sqrtf(freq * note_table[down]) / state->dead_zone_ratio
+        : 0.0f;
+    
+    state->zone_generation = scale->generation;
+}
+
+static void set_tuning_stay_zone(AutoTuneState* state, const Tuning* tuning, int note) {
+    // Same zone as set_stay_zone(), from the tuning's precomputed
+    // boundaries (bounds[count - 1] is already INFINITY)
+    state->zone_high = tuning->bounds[note] * state->dead_zone_ratio;
+    state->zone_low = (note > 0)
+        ? tuning->bounds[note - 1] / state->dead_zone_ratio
+        : 0.0f;
+    
+    state->zone_generation = tuning->generation;
+}
+
+static inline void update_target(AutoTuneState* state, float input_freq) {
+    // Decide whether to switch the target note (once per sample)
+    //
+    // A fixed Hz threshold is under a cent at the top of the range and
+    // ~26 cents at the bottom, so instead the note is kept while the
+    // input stays in its stay zone (set_stay_zone, in cents), and a
+    // switch must wait min_dwell_ms after the previous one.
+    // Inside the zone this is two comparisons, no lookup at all.
+    
+    // A tuning with no notes (never built) falls back to the scale
+    const Tuning* tuning = state->tuning;
+    if (tuning != NULL && tuning->count <= 0) {
+        tuning = NULL;
+    }
+    const Scale* scale = (state->scale != NULL) ? state->scale : &active_scale;
+    uint32_t generation = (tuning != NULL) ? tuning->generation : scale->generation;
+    bool same_scale = (generation == state->zone_generation);
+    
+    if (state->dwell_remaining > 0) {
+        state->dwell_remaining--;
+    }
     
-    // STEP 1: Check if input frequency changed significantly
-    // We only recalculate the target note if the input changed by more than 1 Hz
-    // This saves CPU cycles and prevents jitter
-    float freq_change = fabsf(input_freq - autotune_state.last_input_freq);
+    // Still inside the stay zone: keep the note
+    if (same_scale && input_freq >= state->zone_low && input_freq <= state->zone_high) {
+        return;
+    }
+    
+    // Left the zone, but switched too recently (a scale change always
+    // goes through)
+    if (same_scale && state->dwell_remaining > 0) {
+        return;
+    }
+    
+    // Find the new target note in the voice's tuning or scale
+    // A tuning carries each note's pitch, so non-12-TET notes glide
+    // to the right place without a log2 here
+    int note;
+    float note_freq;
+    float note_pitch;
+    if (tuning != NULL) {
+        note = tuning_nearest_index(tuning, input_freq);
+        note_freq = tuning->freqs[note];
+        note_pitch = tuning->pitches[note];
+    } else {
+        note = quantize_to_scale_index(scale, input_freq);
+        note_freq = note_table[note];
+        note_pitch = (float)(note - A4_NOTE_INDEX);
+    }
     
-    if (freq_change > 1.0f) {
-        // Input changed! Find the new target note
-        autotune_state.target_freq = find_nearest_note(input_freq);
+    // (a rebuilt tuning can put a new frequency at the same index)
+    if (note != state->target_note || note_freq != state->target_freq) {
+        state->target_note = note;
+        state->target_freq = note_freq;
+        state->target_pitch = note_pitch;
+        state->dwell_remaining = state->dwell_samples;
         
-        // Remember this input for next time
-        autotune_state.last_input_freq = input_freq;
+        // A timed glide (linear / S-curve) restarts from where we are
+        state->glide_start_pitch = state->current_pitch;
+        state->glide_position = 0.0f;
     }
     
-    // STEP 2: Smoothly glide current frequency toward target
-    // Instead of instantly jumping to the target (which would cause clicks),
-    // we gradually move toward it
+    // Remember the input that set the target
+    state->last_input_freq = input_freq;
+    if (tuning != NULL) {
+        set_tuning_stay_zone(state, tuning, note);
+    } else {
+        set_stay_zone(state, scale, note);
+    }
+}
+
+static inline float pitch_to_freq(float semitones_from_a4) {
+    // f = 440 × 2^(semitones / 12), via the exp2 table (no powf)
+    return REFERENCE_A4 * fast_exp2f(semitones_from_a4 * (1.0f / 12.0f));
+}
+
+static inline void advance_glide(AutoTuneState* state, float coefficient, float step) {
+    // Move current_pitch one sample toward target_pitch
+    // coefficient: exponential curve, fraction of the remaining distance
+    // step: timed curves, fraction of the whole glide per sample
+    if (state->glide_curve == GLIDE_EXPONENTIAL) {
+        state->current_pitch += (state->target_pitch - state->current_pitch) * coefficient;
+    } else {
+        float position = state->glide_position + step;
+        if (position > 1.0f) position = 1.0f;
+        state->glide_position = position;
+        
+        // S-curve: smoothstep 3p^2 - 2p^3 (zero slope at both ends)
+        float shape = (state->glide_curve == GLIDE_SCURVE)
+            ? position * position * (3.0f - 2.0f * position)
+            : position;
+        
+        state->current_pitch = state->glide_start_pitch
+            + (state->target_pitch - state->glide_start_pitch) * shape;
+    }
+    
+    state->current_freq = pitch_to_freq(state->current_pitch);
+}
+
+static inline float track_center(AutoTuneState* state, float input_freq) {
+    // Slow pitch center of the input for vibrato-preserving mode
+    // One-pole low-pass: a multiply-add per sample. Off (coefficient 0)
+    // the center is the input itself, so input / center = 1.
+    if (state->center_coefficient <= 0.0f || state->center_freq <= 0.0f) {
+        state->center_freq = input_freq;   // Off, or first sample
+    } else {
+        state->center_freq += (input_freq - state->center_freq) * state->center_coefficient;
+    }
+    return state->center_freq;
+}
+
+static inline float apply_vibrato(const AutoTuneState* state, float input_freq, float center) {
+    // Corrected frequency with the input's vibrato (input / center) put
+    // back on. Off, the ratio is 1 by definition, so skip the division:
+    // a 0 Hz input (silence, no pitch) would make it 0 / 0.
+    if (state->center_coefficient <= 0.0f || !(center > 0.0f) || !isfinite(input_freq)) {
+        return state->current_freq;
+    }
+    return state->current_freq * (input_freq / center);
+}
+
+float process_autotune_state(AutoTuneState* state, float input_freq) {
+    // This is the main auto-tune processing function
+    // It takes raw frequency and returns corrected frequency
+    // Everything it reads or writes lives in *state, so voices are
+    // independent
     
-    // Calculate how far we are from the target
-    float difference = autotune_state.target_freq - autotune_state.current_freq;
+    // STEP 1: Check if the input moved to another note
+    // (in vibrato-preserving mode, only the slow center counts)
+    float center = track_center(state, input_freq);
+    update_target(state, center);
     
-    // Move a fraction of that distance (controlled by glide_rate)
+    // STEP 2: Smoothly glide current pitch toward target
+    // Instead of instantly jumping to the target (which would cause clicks),
+    // we gradually move toward it. The glide runs in semitones, so a
+    // glide up an octave takes as long as a glide down an octave.
+    //
+    // Exponential: move a fraction of the distance each call
     // If glide_rate = 1.0, we snap instantly (difference × 1.0 = full jump)
     // If glide_rate = 0.1, we move 10% of the distance each sample
-    float adjustment = difference * glide_rate;
-    
-    // Update our current frequency
-    autotune_state.current_freq += adjustment;
+    // Linear / S-curve: timed by glide_ms at rate_hz
+    advance_glide(state, state->glide_rate, state->glide_step);
     
     // STEP 3: Apply strength parameter
     // Strength controls how much correction to apply:
@@ -158,24 +499,128 @@ float process_autotune(float input_freq, float strength, float glide_rate) {
     // - strength = 0.5: Halfway between
     
     // Calculate the difference between raw and corrected
-    float correction = autotune_state.current_freq - input_freq;
+    // Vibrato-preserving: the corrected center carries the vibrato
+    // (input / center), so strength only moves the center
+    float corrected = apply_vibrato(state, input_freq, center);
+    float correction = corrected - input_freq;
     
     // Apply only a portion of that correction based on strength
-    float output_freq = input_freq + (correction * strength);
+    float output_freq = input_freq + (correction * state->strength);
     
     // Return the final corrected frequency
     return output_freq;
 }
 
+float process_autotune(float input_freq, float strength, float glide_rate) {
+    // Single-voice wrapper (original signature) on autotune_state
+    autotune_state.strength = strength;
+    autotune_state.glide_rate = glide_rate;
+    return process_autotune_state(&autotune_state, input_freq);
+}
+
+void autotune_set_glide_time(AutoTuneState* state, float glide_ms, float rate_hz) {
+    state->glide_ms = glide_ms;
+    state->rate_hz = rate_hz;
+    update_glide(state);
+    
+    // The dwell time and the vibrato filter are counted in samples at rate_hz
+    autotune_set_hysteresis(state, state->dead_zone_cents, state->min_dwell_ms);
+    autotune_set_vibrato(state, state->vibrato_cutoff_hz);
+}
+
+void autotune_set_vibrato(AutoTuneState* state, float vibrato_cutoff_hz) {
+    // One-pole low-pass coefficient: 1 - e^(-2π fc / rate)
+    state->vibrato_cutoff_hz = vibrato_cutoff_hz;
+    if (vibrato_cutoff_hz <= 0.0f || state->rate_hz <= 0.0f) {
+        state->center_coefficient = 0.0f;
+    } else {
+        state->center_coefficient = 1.0f - expf(-6.2831853f * vibrato_cutoff_hz / state->rate_hz);
+    }
+}
+
+void autotune_set_hysteresis(AutoTuneState* state, float dead_zone_cents, float min_dwell_ms) {
+    // Convert to the forms update_target() uses, so the per-sample check
+    // needs no log/exp
+    float ratio = exp2f(dead_zone_cents / 1200.0f);
+    
+    // Re-widen the current stay zone in place. Its edges are the note
+    // midpoints × / ÷ the old ratio; keeping zone_generation means the
+    // zone stays valid, so a switch still waits out dwell_remaining
+    // (INFINITY and 0 edges stay open)
+    if (state->target_note >= 0) {
+        state->zone_high = state->zone_high / state->dead_zone_ratio * ratio;
+        state->zone_low = state->zone_low * state->dead_zone_ratio / ratio;
+    }
+    
+    state->dead_zone_cents = dead_zone_cents;
+    state->min_dwell_ms = min_dwell_ms;
+    state->dead_zone_ratio = ratio;
+    state->dwell_samples = (uint32_t)(min_dwell_ms * 0.001f * state->rate_hz + 0.5f);
+}
+
+void process_autotune_block(AutoTuneState* state, const float* restrict in,
+                            float* restrict out, size_t n) {
+    // Same steps as process_autotune_state(), split into two passes:
+    //   1. target + glide: a recurrence, sample by sample
+    //   2. strength blend: independent per sample, so the compiler can
+    //      vectorize it
+    
+    // Glide coefficient from the time constant (or the step size for
+    // the timed curves), cached when glide_ms or rate_hz was set
+    float coefficient = state->glide_coefficient;
+    float step = state->glide_step;
+    float strength = state->strength;
+    
+    // PASS 1: glide in semitones, writing the fully corrected frequency
+    // to out[]
+    for (size_t i = 0; i < n; i++) {
+        float center = track_center(state, in[i]);
+        update_target(state, center);
+        advance_glide(state, coefficient, step);
+        out[i] = apply_vibrato(state, in[i], center);
+    }
+    
+    // PASS 2: apply strength
+    for (size_t i = 0; i < n; i++) {
+        out[i] = in[i] + (out[i] - in[i]) * strength;
+    }
+}
+
+void process_autotune_voices(AutoTuneState* voices, const float* inputs,
+                             float* outputs, size_t count) {
+    // The voices sit next to each other in memory, so this walks them
+    // in order
+    for (size_t i = 0; i < count; i++) {
+        outputs[i] = process_autotune_state(&voices[i], inputs[i]);
+    }
+}
+
 // ============================================================
 // RESET AUTO-TUNE
 // ============================================================
 
 void reset_autotune(void) {
+    // Single-voice wrapper (original signature) on autotune_state
+    reset_autotune_state(&autotune_state);
+}
+
+void reset_autotune_state(AutoTuneState* state) {
     // Reset the auto-tune state to neutral
     // Call this when switching profiles to avoid glitches
     
-    autotune_state.current_freq = REFERENCE_A4;
-    autotune_state.target_freq = REFERENCE_A4;
-    autotune_state.last_input_freq = 0.0f;
+    state->current_freq = REFERENCE_A4;
+    state->target_freq = REFERENCE_A4;
+    state->last_input_freq = 0.0f;
+    state->current_pitch = 0.0f;      // A4
+    state->target_pitch = 0.0f;
+    state->glide_start_pitch = 0.0f;
+    state->glide_position = 1.0f;     // No timed glide in progress
+    state->center_freq = 0.0f;        // Vibrato center restarts on the next input
+    
+    // No target note yet: the first input always picks one
+    state->target_note = -1;
+    state->zone_low = 0.0f;
+    state->zone_high = 0.0f;
+    state->zone_generation = 0;
+    state->dwell_remaining = 0;
 }
\ No newline at end of file
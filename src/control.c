@@ -0,0 +1,63 @@
+// control.c
+// Implementation of the control-rate ring buffer
+
+#include "../include/control.h"
+
+// ============================================================
+// RING BUFFER
+// ============================================================
+
+void control_ring_init(ControlRing* ring, ControlPoint initial) {
+    ring->head = 0;
+    ring->tail = 0;
+    ring->last = initial;
+    ring->overruns = 0;
+    ring->underruns = 0;
+}
+
+bool control_ring_push(ControlRing* ring, const ControlPoint* point) {
+    // Runs in the control core (core 1) loop
+    // head and tail count up forever; the slot is index & MASK, and
+    // head - tail is the fill level even after they wrap
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if (head - tail >= CONTROL_RING_SIZE) {
+        ring->overruns++;
+        return false;
+    }
+
+    ring->points[head & CONTROL_RING_MASK] = *point;
+
+    // Publish the point only after it is written
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+size_t control_ring_pop(ControlRing* ring, ControlPoint* out, size_t count) {
+    // Runs in the audio loop, once per block
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t available = head - tail;
+
+    // STEP 1: Bound the latency: keep at most one extra block queued
+    if (available > 2 * count) {
+        tail += available - 2 * count;
+        available = 2 * (uint32_t)count;
+    }
+
+    // STEP 2: Take the fresh points, then hold the last one
+    size_t fresh = (available < count) ? available : count;
+    for (size_t i = 0; i < fresh; i++) {
+        ring->last = ring->points[(tail + i) & CONTROL_RING_MASK];
+        out[i] = ring->last;
+    }
+    for (size_t i = fresh; i < count; i++) {
+        out[i] = ring->last;
+    }
+    ring->underruns += (uint32_t)(count - fresh);
+
+    // Hand the slots back to the producer
+    __atomic_store_n(&ring->tail, tail + (uint32_t)fresh, __ATOMIC_RELEASE);
+    return fresh;
+}
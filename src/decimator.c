@@ -0,0 +1,92 @@
+// decimator.c
+// Implementation of the CIC + compensation FIR decimator
+
+#include "../include/decimator.h"
+
+// ============================================================
+// INITIALIZATION
+// ============================================================
+
+void decimator_init(Decimator* decimator) {
+    for (int k = 0; k < CIC_STAGES; k++) {
+        decimator->integrator[k] = 0;
+        decimator->comb_delay[k] = 0;
+    }
+    decimator->phase = 0;
+    decimator->fir_history[0] = 0;
+    decimator->fir_history[1] = 0;
+    decimator->warmup = CIC_STAGES;
+    decimator->primed = false;
+}
+
+// ============================================================
+// FILTERING
+// ============================================================
+
+static inline uint16_t compensate(Decimator* decimator, int32_t value) {
+    // 3-tap FIR [-1, 18, -1] / 16 at the output rate
+    // A 2-stage CIC droops like sinc^2 toward the top of the passband;
+    // this lifts it back by 1 + (πf)^2 / 4 at low f (3/4 of the exact
+    // 1/sinc^2, which keeps the FIR's own noise gain down to 1.13) with
+    // unity gain at DC. Delays the output by one sample.
+    if (!decimator->primed) {
+        // Start from the first value instead of ramping up from 0
+        decimator->fir_history[0] = value;
+        decimator->fir_history[1] = value;
+        decimator->primed = true;
+    }
+
+    int32_t center = decimator->fir_history[0];
+    int32_t result = (18 * center - value - decimator->fir_history[1] + 8) >> 4;   // Rounded
+
+    decimator->fir_history[1] = center;
+    decimator->fir_history[0] = value;
+
+    // The overshoot of the compensation can leave the 16-bit range
+    if (result < 0) result = 0;
+    if (result > 0xFFFF) result = 0xFFFF;
+    return (uint16_t)result;
+}
+
+size_t decimator_process(Decimator* decimator, const uint16_t* in, size_t n, uint16_t* out) {
+    // Local copies keep the state in registers through the loop
+    uint32_t i0 = decimator->integrator[0];
+    uint32_t i1 = decimator->integrator[1];
+    uint32_t phase = decimator->phase;
+    size_t written = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        // STEP 1: Integrators, at the ADC rate (two adds per sample)
+        i0 += in[i];
+        i1 += i0;
+
+        if (++phase < CIC_DECIMATION) {
+            continue;
+        }
+        phase = 0;
+
+        // STEP 2: Combs, at the output rate
+        uint32_t value = i1;
+        for (int k = 0; k < CIC_STAGES; k++) {
+            uint32_t delayed = decimator->comb_delay[k];
+            decimator->comb_delay[k] = value;
+            value -= delayed;
+        }
+
+        // Until every comb has seen a real value, the output is a ramp
+        if (decimator->warmup > 0) {
+            decimator->warmup--;
+            continue;
+        }
+        
+        // STEP 3: Remove the CIC gain (keeping the extra bits, rounded
+        // so the output has no half-LSB offset), then compensate the droop
+        value = (value + (1u << (CIC_OUTPUT_SHIFT - 1))) >> CIC_OUTPUT_SHIFT;
+        out[written++] = compensate(decimator, (int32_t)value);
+    }
+
+    decimator->integrator[0] = i0;
+    decimator->integrator[1] = i1;
+    decimator->phase = phase;
+    return written;
+}
@@ -0,0 +1,195 @@
+// fastmath.c
+// Implementation of the fast math approximations
+
+#include "../include/fastmath.h"
+#include <math.h>
+
+// ============================================================
+// TABLES
+// ============================================================
+
+// 2^(i / 64), i = 0..64
+const float exp2_table[EXP2_TABLE_SIZE + 1] = {
+    1.000000000f, 1.010889286f, 1.021897149f, 1.033024879f,
+    1.044273782f, 1.055645178f, 1.067140401f, 1.078760798f,
+    1.090507733f, 1.102382583f, 1.114386743f, 1.126521619f,
+    1.138788635f, 1.151189230f, 1.163724859f, 1.176396992f,
+    1.189207115f, 1.202156731f, 1.215247360f, 1.228480536f,
+    1.241857812f, 1.255380757f, 1.269050957f, 1.282870016f,
+    1.296839555f, 1.310961212f, 1.325236643f, 1.339667524f,
+    1.354255547f, 1.369002423f, 1.383909882f, 1.398979673f,
+    1.414213562f, 1.429613338f, 1.445180807f, 1.460917794f,
+    1.476826146f, 1.492907728f, 1.509164428f, 1.525598151f,
+    1.542210825f, 1.559004400f, 1.575980845f, 1.593142151f,
+    1.610490332f, 1.628027422f, 1.645755478f, 1.663676580f,
+    1.681792831f, 1.700106354f, 1.718619298f, 1.737333835f,
+    1.756252160f, 1.775376493f, 1.794709075f, 1.814252176f,
+    1.834008086f, 1.853979125f, 1.874167634f, 1.894575982f,
+    1.915206561f, 1.936061793f, 1.957144124f, 1.978456026f,
+    2.000000000f
+};
+
+// log2(1 + i / 64), i = 0..64
+const float log2_table[LOG2_TABLE_SIZE + 1] = {
+    0.000000000f, 0.022367813f, 0.044394119f, 0.066089190f,
+    0.087462841f, 0.108524457f, 0.129283017f, 0.149747120f,
+    0.169925001f, 0.189824559f, 0.209453366f, 0.228818690f,
+    0.247927513f, 0.266786541f, 0.285402219f, 0.303780748f,
+    0.321928095f, 0.339850003f, 0.357552005f, 0.375039431f,
+    0.392317423f, 0.409390936f, 0.426264755f, 0.442943496f,
+    0.459431619f, 0.475733431f, 0.491853096f, 0.507794640f,
+    0.523561956f, 0.539158811f, 0.554588852f, 0.569855608f,
+    0.584962501f, 0.599912842f, 0.614709844f, 0.629356620f,
+    0.643856190f, 0.658211483f, 0.672425342f, 0.686500527f,
+    0.700439718f, 0.714245518f, 0.727920455f, 0.741466986f,
+    0.754887502f, 0.768184325f, 0.781359714f, 0.794415866f,
+    0.807354922f, 0.820178962f, 0.832890014f, 0.845490051f,
+    0.857980995f, 0.870364720f, 0.882643049f, 0.894817763f,
+    0.906890596f, 0.918863237f, 0.930737338f, 0.942514505f,
+    0.954196310f, 0.965784285f, 0.977279923f, 0.988684687f,
+    1.000000000f
+};
+
+// 2^(i / 64) in Q2.30, i = 0..64 (for the fixed-point exp2)
+const uint32_t exp2_table_q30[EXP2_TABLE_SIZE + 1] = {
+    0x40000000u, 0x40B268FAu, 0x4166C34Cu, 0x421D1462u,
+    0x42D561B4u, 0x438FB0CBu, 0x444C0740u, 0x450A6ABBu,
+    0x45CAE0F2u, 0x468D6FAEu, 0x47521CC6u, 0x4818EE22u,
+    0x48E1E9BAu, 0x49AD1598u, 0x4A7A77D4u, 0x4B4A169Cu,
+    0x4C1BF829u, 0x4CF022CAu, 0x4DC69CDDu, 0x4E9F6CD4u,
+    0x4F7A9930u, 0x50582888u, 0x51382182u, 0x521A8AD7u,
+    0x52FF6B55u, 0x53E6C9DAu, 0x54D0AD5Au, 0x55BD1CDBu,
+    0x56AC1F75u, 0x579DBC57u, 0x5891FAC1u, 0x5988E209u,
+    0x5A82799Au, 0x5B7EC8F2u, 0x5C7DD7A4u, 0x5D7FAD59u,
+    0x5E8451D0u, 0x5F8BCCDBu, 0x60962665u, 0x61A3666Du,
+    0x62B39509u, 0x63C6BA64u, 0x64DCDEC3u, 0x65F60A7Fu,
+    0x6712460Bu, 0x683199EDu, 0x69540EC9u, 0x6A79AD56u,
+    0x6BA27E65u, 0x6CCE8AE1u, 0x6DFDDBCCu, 0x6F307A41u,
+    0x70666F76u, 0x719FC4B9u, 0x72DC8374u, 0x741CB528u,
+    0x75606374u, 0x76A7980Fu, 0x77F25CCEu, 0x7940BB9Eu,
+    0x7A92BE8Bu, 0x7BE86FBAu, 0x7D41D96Eu, 0x7E9F0606u,
+    0x80000000u
+};
+
+// log2(1 + i / 64) in Q2.30, i = 0..64 (for the fixed-point log2)
+const uint32_t log2_table_q30[LOG2_TABLE_SIZE + 1] = {
+    0x00000000u, 0x016E7968u, 0x02D75A6Fu, 0x043ACE28u,
+    0x0598FDBFu, 0x06F21090u, 0x08462C46u, 0x099574F1u,
+    0x0AE00D1Du, 0x0C2615E8u, 0x0D67AF17u, 0x0EA4F726u,
+    0x0FDE0B5Du, 0x111307DBu, 0x124407ABu, 0x137124CFu,
+    0x149A784Cu, 0x15C01A3Au, 0x16E221CEu, 0x1800A563u,
+    0x191BBA89u, 0x1A33760Au, 0x1B47EBF7u, 0x1C592FADu,
+    0x1D6753E0u, 0x1E726AA2u, 0x1F7A8569u, 0x207FB517u,
+    0x21820A02u, 0x228193F5u, 0x237E623Du, 0x247883A8u,
+    0x2570068Eu, 0x2664F8D5u, 0x275767F5u, 0x284760FDu,
+    0x2934F098u, 0x2A20230Eu, 0x2B09044Du, 0x2BEF9FE8u,
+    0x2CD4011Du, 0x2DB632D5u, 0x2E963FADu, 0x2F7431F2u,
+    0x305013ABu, 0x3129EE96u, 0x3201CC2Cu, 0x32D7B5A5u,
+    0x33ABB3FBu, 0x347DCFE7u, 0x354E11EBu, 0x361C824Du,
+    0x36E9291Fu, 0x37B40E3Au, 0x387D3946u, 0x3944B1B9u,
+    0x3A0A7EDAu, 0x3ACEA7C0u, 0x3B913356u, 0x3C52285Cu,
+    0x3D118D67u, 0x3DCF68E3u, 0x3E8BC118u, 0x3F469C23u,
+    0x40000000u
+};
+
+// ============================================================
+// EXP2
+// ============================================================
+
+float fast_exp2f(float x) {
+    // Split x into integer and fraction: 2^x = 2^i × 2^f, f in [0, 1)
+    float whole = floorf(x);
+    float frac = x - whole;
+    int32_t exponent = (int32_t)whole;
+    
+    // 2^f: table segment + linear interpolation inside it
+    float position = frac * (float)EXP2_TABLE_SIZE;
+    int index = (int)position;
+    if (index > EXP2_TABLE_SIZE - 1) {
+        index = EXP2_TABLE_SIZE - 1;   // frac rounded up to 1.0
+    }
+    float t = position - (float)index;
+    float mantissa = exp2_table[index] + (exp2_table[index + 1] - exp2_table[index]) * t;
+    
+    // 2^i: build the float 2^i directly from its exponent bits
+    union { float f; uint32_t i; } scale;
+    scale.i = (uint32_t)(exponent + 127) << 23;
+    
+    return mantissa * scale.f;
+}
+
+// ============================================================
+// LOG2
+// ============================================================
+
+float fast_log2f(float x) {
+    // log2(x) = exponent + log2(mantissa), mantissa in [1, 2)
+    // Both come straight out of the float's bits; only log2(mantissa)
+    // needs the table.
+    union { float f; uint32_t i; } bits = { x };
+    
+    float exponent = (float)((int32_t)((bits.i >> 23) & 0xFF) - 127);
+    
+    // Top 6 mantissa bits pick the segment, the other 17 interpolate
+    uint32_t mantissa = bits.i & 0x007FFFFF;
+    uint32_t index = mantissa >> (23 - LOG2_TABLE_BITS);
+    float t = (float)(mantissa & ((1u << (23 - LOG2_TABLE_BITS)) - 1))
+            * (1.0f / (float)(1u << (23 - LOG2_TABLE_BITS)));
+    
+    return exponent + log2_table[index] + (log2_table[index + 1] - log2_table[index]) * t;
+}
+
+// ============================================================
+// FIXED POINT
+// ============================================================
+
+uint32_t fast_exp2_q16(int32_t x) {
+    // Same split as fast_exp2f(), all in integers:
+    //   whole = floor(x), frac = x - whole (16 bits)
+    //   2^frac from the Q30 table, then shifted by whole
+    if (x >= (16 << 16)) {
+        return UINT32_MAX;   // 2^16 doesn't fit in Q16.16
+    }
+    if (x < -(16 << 16)) {
+        return 0;
+    }
+    
+    int32_t whole = x >> 16;               // Arithmetic shift = floor
+    uint32_t frac = (uint32_t)x & 0xFFFF;
+    
+    // Top 6 fraction bits pick the segment, the low 10 interpolate
+    uint32_t index = frac >> (16 - EXP2_TABLE_BITS);
+    uint32_t t = frac & ((1u << (16 - EXP2_TABLE_BITS)) - 1);
+    uint32_t step = exp2_table_q30[index + 1] - exp2_table_q30[index];
+    uint32_t mantissa = exp2_table_q30[index]
+        + (uint32_t)(((uint64_t)step * t) >> (16 - EXP2_TABLE_BITS));
+    
+    // Q30 mantissa → Q16 result, times 2^whole
+    int32_t shift = 14 - whole;
+    if (shift > 0) {
+        return (mantissa + (1u << (shift - 1))) >> shift;   // Rounded
+    }
+    return mantissa << -shift;
+}
+
+int32_t fast_log2_q16(uint32_t x) {
+    // Integer part from the position of the top bit (one CLZ
+    // instruction on the M33), fraction from the table
+    if (x == 0) {
+        return INT32_MIN;
+    }
+    
+    int leading_zeros = __builtin_clz(x);
+    int32_t exponent = 15 - leading_zeros;   // Top bit position - 16
+    
+    // Normalize: drop the top bit, leaving the mantissa fraction in
+    // all 32 bits
+    uint32_t frac = (x << leading_zeros) << 1;
+    uint32_t index = frac >> (32 - LOG2_TABLE_BITS);
+    uint32_t t = (frac >> (32 - LOG2_TABLE_BITS - 16)) & 0xFFFF;
+    uint32_t step = log2_table_q30[index + 1] - log2_table_q30[index];
+    uint32_t log_mantissa = log2_table_q30[index] + (uint32_t)(((uint64_t)step * t) >> 16);
+    
+    // Q30 → Q16, rounded
+    return exponent * 65536 + (int32_t)((log_mantissa + (1u << 13)) >> 14);
+}
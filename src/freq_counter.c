@@ -0,0 +1,106 @@
+// freq_counter.c
+// Implementation of the non-blocking frequency-counter service
+
+#include "../include/freq_counter.h"
+#include "../include/fastmath.h"
+#include <math.h>
+
+// ============================================================
+// HELPERS
+// ============================================================
+
+static inline float result_to_hz(uint32_t result) {
+    // Result register: kHz in bits 29..5, 1/32 kHz in bits 4..0
+    return (float)result * (1000.0f / (float)(1u << CLOCKS_FC0_RESULT_KHZ_LSB));
+}
+
+static void start_measurement(FreqCounter* counter) {
+    // Same register sequence as the old blocking find_freq(); writing
+    // src starts the count
+    fc_hw_t* fc = counter->hw;
+
+    fc->ref_khz = counter->ref_khz;
+    fc->interval = counter->interval;
+    fc->min_khz = 0;            // No pass/fail limits
+    fc->max_khz = 0xffffffff;
+    fc->src = counter->src;
+
+    counter->measuring = true;
+}
+
+static void adapt_interval(FreqCounter* counter, uint32_t previous, uint32_t result) {
+    // Trade resolution for latency by how fast the pitch moves between
+    // two measurements: a sliding hand wants fresh results, a held note
+    // wants fine ones
+    if (previous == 0 || result == 0) {
+        return;
+    }
+
+    float cents = fabsf(1200.0f * (fast_log2f((float)result) - fast_log2f((float)previous)));
+
+    if (cents > FREQ_COUNTER_FAST_CENTS && counter->interval > FREQ_COUNTER_MIN_INTERVAL) {
+        counter->interval--;   // Half the time per measurement
+    } else if (cents < FREQ_COUNTER_SLOW_CENTS && counter->interval < FREQ_COUNTER_MAX_INTERVAL) {
+        counter->interval++;   // Twice the time, finer result
+    }
+}
+
+// ============================================================
+// SERVICE
+// ============================================================
+
+void freq_counter_init(FreqCounter* counter, fc_hw_t* hw, uint32_t src, uint32_t ref_khz) {
+    counter->hw = hw;
+    counter->src = src;
+    counter->ref_khz = ref_khz;
+    counter->interval = FREQ_COUNTER_MAX_INTERVAL;
+    counter->measuring = false;
+    counter->latest_result = 0;
+    counter->sequence = 0;
+    counter->callback = NULL;
+    counter->user_data = NULL;
+}
+
+void freq_counter_set_callback(FreqCounter* counter, FreqCounterCallback callback,
+                               void* user_data) {
+    counter->callback = callback;
+    counter->user_data = user_data;
+}
+
+bool freq_counter_poll(FreqCounter* counter) {
+    fc_hw_t* fc = counter->hw;
+    uint32_t status = fc->status;
+
+    // STEP 1: Nothing in flight: start one (unless someone else's
+    // measurement is still running)
+    if (!counter->measuring) {
+        if (!(status & CLOCKS_FC0_STATUS_RUNNING_BITS)) {
+            start_measurement(counter);
+        }
+        return false;
+    }
+
+    // STEP 2: In flight and not done yet: come back later
+    if ((status & CLOCKS_FC0_STATUS_RUNNING_BITS) || !(status & CLOCKS_FC0_STATUS_DONE_BITS)) {
+        return false;
+    }
+
+    // STEP 3: Done: publish, adapt, and start the next one right away
+    uint32_t result = fc->result;
+    uint32_t previous = counter->latest_result;
+
+    counter->latest_result = result;
+    counter->sequence = counter->sequence + 1;
+
+    adapt_interval(counter, previous, result);
+    start_measurement(counter);
+
+    if (counter->callback != NULL) {
+        counter->callback(result_to_hz(result), counter->user_data);
+    }
+    return true;
+}
+
+float freq_counter_latest(const FreqCounter* counter) {
+    return result_to_hz(counter->latest_result);
+}
@@ -15,7 +15,7 @@ void init_adc();
 void init_adc_freerun();
 void init_dma();
 void init_input();
-void find_freq();
+float find_freq(void);
 void get_pitch();
 void get_vol();
 void init_wavetable(void);
@@ -0,0 +1,90 @@
+// noise_shaper.c
+// Implementation of the error-feedback noise-shaping requantizer
+
+#include "../include/noise_shaper.h"
+
+// ============================================================
+// INITIALIZATION
+// ============================================================
+
+void noise_shaper_init(NoiseShaper* shaper, uint32_t levels, NoiseShapeOrder order) {
+    shaper->levels = levels;
+    noise_shaper_set_order(shaper, order);
+}
+
+void noise_shaper_set_order(NoiseShaper* shaper, NoiseShapeOrder order) {
+    // Past NOISE_SHAPER_MAX_LEVELS the 16.16 sample no longer fits in 32
+    // bits (at 65536 levels full scale wraps to 0). Truncation is all
+    // that's needed there: each 16-bit sample gets a level of its own.
+    if (shaper->levels > NOISE_SHAPER_MAX_LEVELS) {
+        order = NOISE_SHAPE_NONE;
+    }
+    shaper->order = order;
+    shaper->error[0] = 0;
+    shaper->error[1] = 0;
+    shaper->error[2] = 0;
+}
+
+// ============================================================
+// REQUANTIZATION
+// ============================================================
+
+void noise_shaper_process(NoiseShaper* shaper, const int16_t* in, uint16_t* out, size_t n) {
+    const uint32_t levels = shaper->levels;
+    const int32_t top = (int32_t)levels - 1;
+
+    // Without feedback: truncate, exactly as the PWM did before
+    if (shaper->order == NOISE_SHAPE_NONE) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = (uint16_t)(((uint32_t)((int32_t)in[i] + 32768) * levels) >> 16);
+        }
+        return;
+    }
+
+    // Local copies keep the state in registers through the loop
+    int32_t e1 = shaper->error[0];
+    int32_t e2 = shaper->error[1];
+    int32_t e3 = shaper->error[2];
+
+    for (size_t i = 0; i < n; i++) {
+        // STEP 1: The sample in levels, 16.16 (fits with room for the
+        // feedback: levels ≤ NOISE_SHAPER_MAX_LEVELS)
+        int32_t wanted = (int32_t)((uint32_t)((int32_t)in[i] + 32768) * levels);
+
+        // STEP 2: Subtract the filtered past errors, so the output
+        // error is E × (1 - z^-1)^order (binomial taps 1; 2, -1; 3, -3, 1)
+        int32_t shaped;
+        switch (shaper->order) {
+            case NOISE_SHAPE_FIRST:
+                shaped = wanted - e1;
+                break;
+            case NOISE_SHAPE_SECOND:
+                shaped = wanted - 2 * e1 + e2;
+                break;
+            default:
+                shaped = wanted - 3 * e1 + 3 * e2 - e3;
+                break;
+        }
+
+        // STEP 3: Round to the nearest level (the shift floors, so add
+        // half a level first)
+        int32_t level = (shaped + (1 << (NOISE_SHAPER_FRAC_BITS - 1))) >> NOISE_SHAPER_FRAC_BITS;
+        if (level < 0) level = 0;
+        if (level > top) level = top;
+        out[i] = (uint16_t)level;
+
+        // STEP 4: Remember this error. Near full scale the clamp above
+        // can make it large; limiting what is fed back keeps the loop
+        // from running away (higher orders are only conditionally stable)
+        int32_t error = (level << NOISE_SHAPER_FRAC_BITS) - shaped;
+        if (error > NOISE_SHAPER_ERROR_LIMIT) error = NOISE_SHAPER_ERROR_LIMIT;
+        if (error < -NOISE_SHAPER_ERROR_LIMIT) error = -NOISE_SHAPER_ERROR_LIMIT;
+        e3 = e2;
+        e2 = e1;
+        e1 = error;
+    }
+
+    shaper->error[0] = e1;
+    shaper->error[1] = e2;
+    shaper->error[2] = e3;
+}
@@ -0,0 +1,178 @@
+// pipeline.c
+// Implementation of the dual-core plumbing: parameter snapshots, the
+// inter-core FIFO and core 1 start-up (pthreads on the host)
+
+#include "../include/pipeline.h"
+
+#if !defined(HOST_TEST)
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+// ============================================================
+// PARAMETER SNAPSHOTS (TRIPLE BUFFER)
+// ============================================================
+
+void snapshot_init(ParamSnapshots* snapshots, const AudioParams* initial) {
+    for (int i = 0; i < 3; i++) {
+        snapshots->slots[i] = *initial;
+    }
+    snapshots->back = 0;
+    snapshots->middle = 1;
+    snapshots->front = 2;
+}
+
+void snapshot_publish(ParamSnapshots* snapshots, const AudioParams* params) {
+    // Fill the writer's own slot, then swap it into the middle marked
+    // fresh; whatever was in the middle becomes the next slot to write
+    snapshots->slots[snapshots->back] = *params;
+
+    uint32_t published = snapshots->back | PIPELINE_SNAPSHOT_FRESH;
+    uint32_t previous = __atomic_exchange_n(&snapshots->middle, published, __ATOMIC_ACQ_REL);
+    snapshots->back = previous & ~PIPELINE_SNAPSHOT_FRESH;
+}
+
+const AudioParams* snapshot_latest(ParamSnapshots* snapshots) {
+    // Only swap when there is something new; otherwise keep reading the
+    // slot we already have
+    if (__atomic_load_n(&snapshots->middle, __ATOMIC_ACQUIRE) & PIPELINE_SNAPSHOT_FRESH) {
+        uint32_t previous = __atomic_exchange_n(&snapshots->middle, snapshots->front, __ATOMIC_ACQ_REL);
+        snapshots->front = previous & ~PIPELINE_SNAPSHOT_FRESH;
+    }
+    return &snapshots->slots[snapshots->front];
+}
+
+#if !defined(HOST_TEST)
+
+// ============================================================
+// DEVICE: SIO FIFO, CORE 1
+// ============================================================
+
+void pipeline_launch_control_core(void (*entry)(void)) {
+    multicore_launch_core1(entry);
+}
+
+uint32_t pipeline_core_num(void) {
+    return get_core_num();
+}
+
+bool pipeline_fifo_push(uint32_t message) {
+    if (!multicore_fifo_wready()) {
+        return false;
+    }
+    multicore_fifo_push_blocking(message);
+    return true;
+}
+
+void pipeline_fifo_push_blocking(uint32_t message) {
+    multicore_fifo_push_blocking(message);
+}
+
+bool pipeline_fifo_pop(uint32_t* message) {
+    if (!multicore_fifo_rvalid()) {
+        return false;
+    }
+    *message = multicore_fifo_pop_blocking();
+    return true;
+}
+
+uint32_t pipeline_fifo_pop_blocking(void) {
+    return multicore_fifo_pop_blocking();
+}
+
+#else
+
+// ============================================================
+// HOST: PTHREADS AS CORES
+// ============================================================
+
+// One queue per direction, indexed by the sending core; same shape as
+// the other rings (indices count up, head - tail = fill level)
+typedef struct {
+    uint32_t words[PIPELINE_FIFO_DEPTH];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+} HostFifo;
+
+static HostFifo host_fifos[2];
+static pthread_t control_thread;
+static void (*control_entry)(void) = NULL;
+static __thread uint32_t host_core_num = PIPELINE_AUDIO_CORE;
+
+static void host_wait(void) {
+    // Give the other thread the CPU (a spin would burn a whole time
+    // slice on a single-core host)
+    struct timespec pause = { 0, 1000 };
+    nanosleep(&pause, NULL);
+}
+
+static void* control_thread_main(void* arg) {
+    (void)arg;
+    host_core_num = PIPELINE_CONTROL_CORE;
+    control_entry();
+    return NULL;
+}
+
+void pipeline_launch_control_core(void (*entry)(void)) {
+    // Fresh FIFOs, as after a core 1 reset
+    for (int i = 0; i < 2; i++) {
+        host_fifos[i].head = 0;
+        host_fifos[i].tail = 0;
+    }
+    control_entry = entry;
+    pthread_create(&control_thread, NULL, control_thread_main, NULL);
+}
+
+void pipeline_join_control_core(void) {
+    pthread_join(control_thread, NULL);
+}
+
+uint32_t pipeline_core_num(void) {
+    return host_core_num;
+}
+
+bool pipeline_fifo_push(uint32_t message) {
+    HostFifo* fifo = &host_fifos[host_core_num];
+    uint32_t head = fifo->head;
+    uint32_t tail = __atomic_load_n(&fifo->tail, __ATOMIC_ACQUIRE);
+
+    if (head - tail >= PIPELINE_FIFO_DEPTH) {
+        return false;
+    }
+    fifo->words[head % PIPELINE_FIFO_DEPTH] = message;
+    __atomic_store_n(&fifo->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+void pipeline_fifo_push_blocking(uint32_t message) {
+    while (!pipeline_fifo_push(message)) {
+        host_wait();
+    }
+}
+
+bool pipeline_fifo_pop(uint32_t* message) {
+    // Read the other core's sending queue
+    HostFifo* fifo = &host_fifos[host_core_num ^ 1];
+    uint32_t tail = fifo->tail;
+    uint32_t head = __atomic_load_n(&fifo->head, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        return false;
+    }
+    *message = fifo->words[tail % PIPELINE_FIFO_DEPTH];
+    __atomic_store_n(&fifo->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+uint32_t pipeline_fifo_pop_blocking(void) {
+    uint32_t message;
+    while (!pipeline_fifo_pop(&message)) {
+        host_wait();
+    }
+    return message;
+}
+
+#endif
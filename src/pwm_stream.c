@@ -0,0 +1,318 @@
+// pwm_stream.c
+// Implementation of the DMA-driven PWM audio output
+// (and its host stand-in for unit tests)
+
+#include "../include/pwm_stream.h"
+
+#if !defined(HOST_TEST)
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+#include "pico/stdlib.h"
+#endif
+
+// ============================================================
+// SHARED: LEVELS, BLOCK HAND-OVER
+// ============================================================
+
+static void convert_block(PwmStream* stream, uint16_t* block, const int16_t* samples) {
+    // -32768..32767 → 0..top, mid-scale at silence
+    noise_shaper_process(&stream->shaper, samples, block, PWM_STREAM_BLOCK_SIZE);
+}
+
+static int next_block(const PwmStream* stream) {
+    // The block after the one playing; before start, block 0 then 1
+    int playing = stream->playing;
+    if (playing >= 0) {
+        return playing ^ 1;
+    }
+    return stream->filled[0] ? 1 : 0;
+}
+
+static void block_done(PwmStream* stream, int block) {
+    // Runs in the DMA completion interrupt: block has drained and the
+    // chain has already started its partner
+    int partner = block ^ 1;
+
+    stream->filled[block] = false;
+    stream->playing = partner;
+    stream->blocks_played++;
+
+    // Nobody refilled the partner in time: it plays its old samples
+    if (!stream->filled[partner]) {
+        stream->underruns++;
+    }
+
+    // Refill the drained block now; it plays after the partner
+    if (stream->fill != NULL) {
+        stream->fill(stream->fill_samples, PWM_STREAM_BLOCK_SIZE, stream->user_data);
+        convert_block(stream, stream->blocks[block], stream->fill_samples);
+        stream->filled[block] = true;
+    }
+}
+
+static void prime_blocks(PwmStream* stream) {
+    // With a fill callback, start from its samples rather than silence
+    if (stream->fill == NULL) {
+        return;
+    }
+    for (int i = 0; i < PWM_STREAM_BLOCKS; i++) {
+        if (!stream->filled[i]) {
+            stream->fill(stream->fill_samples, PWM_STREAM_BLOCK_SIZE, stream->user_data);
+            convert_block(stream, stream->blocks[i], stream->fill_samples);
+            stream->filled[i] = true;
+        }
+    }
+}
+
+static void init_blocks(PwmStream* stream, uint16_t top) {
+    stream->top = top;
+    noise_shaper_init(&stream->shaper, (uint32_t)top + 1, NOISE_SHAPE_NONE);
+    for (int i = 0; i < PWM_STREAM_BLOCKS; i++) {
+        stream->blocks[i] = &stream->buffer[i * PWM_STREAM_BLOCK_SIZE];
+        stream->dma_channel[i] = -1;
+        stream->filled[i] = false;
+        for (int j = 0; j < PWM_STREAM_BLOCK_SIZE; j++) {
+            stream->blocks[i][j] = (uint16_t)((top + 1u) / 2);   // Silence
+        }
+    }
+    stream->dma_timer = -1;
+    stream->playing = -1;
+    stream->blocks_played = 0;
+    stream->underruns = 0;
+    stream->fill = NULL;
+    stream->user_data = NULL;
+    stream->read_position = 0;
+    stream->recording = NULL;
+    stream->recording_capacity = 0;
+    stream->recorded = 0;
+}
+
+void pwm_stream_set_fill(PwmStream* stream, PwmStreamFill fill, void* user_data) {
+    stream->fill = fill;
+    stream->user_data = user_data;
+}
+
+void pwm_stream_set_noise_shaping(PwmStream* stream, NoiseShapeOrder order) {
+    noise_shaper_set_order(&stream->shaper, order);
+}
+
+bool pwm_stream_ready(const PwmStream* stream) {
+    return !stream->filled[next_block(stream)];
+}
+
+bool pwm_stream_write_block(PwmStream* stream, const int16_t* samples) {
+    // If the interrupt moves on while this runs, the stream has already
+    // underrun; the block is then written while it plays (counted as
+    // an underrun, not prevented)
+    int block = next_block(stream);
+    if (stream->filled[block]) {
+        return false;
+    }
+
+    convert_block(stream, stream->blocks[block], samples);
+    stream->filled[block] = true;
+    return true;
+}
+
+float pwm_stream_pacing_fraction(uint32_t clock_hz, float sample_rate_hz,
+                                 uint16_t* numerator, uint16_t* denominator) {
+    // Try every denominator; the numerator follows from it. Runs once
+    // at init, so the 65535 steps don't matter.
+    double target = (double)sample_rate_hz / (double)clock_hz;
+    double best_error = 2.0;
+    uint32_t best_x = 1;
+    uint32_t best_y = 1;
+
+    for (uint32_t y = 1; y <= 0xFFFF; y++) {
+        uint32_t x = (uint32_t)(target * (double)y + 0.5);
+        if (x == 0 || x > y) {
+            continue;   // The timer can't run faster than the clock
+        }
+
+        double error = (double)x / (double)y - target;
+        if (error < 0.0) error = -error;
+        if (error < best_error) {
+            best_error = error;
+            best_x = x;
+            best_y = y;
+        }
+    }
+
+    *numerator = (uint16_t)best_x;
+    *denominator = (uint16_t)best_y;
+    return (float)((double)clock_hz * (double)best_x / (double)best_y);
+}
+
+#if !defined(HOST_TEST)
+
+// ============================================================
+// DEVICE: PWM + PACED, CHAINED DMA
+// ============================================================
+
+// The interrupt handler has no argument, so it checks every stream set
+// up so far. Each stream needs its own pacing timer, and there are four.
+#define MAX_STREAMS 4
+static PwmStream* active_streams[MAX_STREAMS];
+static volatile int active_count = 0;
+
+static void dma_completion_handler(void) {
+    for (int s = 0; s < active_count; s++) {
+        PwmStream* stream = active_streams[s];
+
+        for (int i = 0; i < PWM_STREAM_BLOCKS; i++) {
+            int channel = stream->dma_channel[i];
+            if (dma_channel_get_irq0_status(channel)) {
+                dma_channel_acknowledge_irq0(channel);
+                block_done(stream, i);
+            }
+        }
+    }
+}
+
+static void register_stream(PwmStream* stream) {
+    for (int s = 0; s < active_count; s++) {
+        if (active_streams[s] == stream) {
+            return;   // Set up again: already served
+        }
+    }
+
+    // Entry before count, so the handler never sees an empty slot;
+    // the handler itself goes in once, with the first stream
+    active_streams[active_count] = stream;
+    active_count++;
+    if (active_count == 1) {
+        irq_add_shared_handler(DMA_IRQ_0, dma_completion_handler,
+                               PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+    }
+}
+
+void pwm_stream_init(PwmStream* stream, uint32_t pin, uint16_t top, float sample_rate_hz) {
+    init_blocks(stream, top);
+
+    // STEP 1: PWM slice, free-running at clk_sys with wrap at top. The
+    // compare register is double-buffered, so a new level takes effect
+    // at the next wrap with no glitch.
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+    stream->slice = pwm_gpio_to_slice_num(pin);
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_wrap(&config, top);
+    pwm_init(stream->slice, &config, true);
+    pwm_set_gpio_level(pin, (uint16_t)((top + 1u) / 2));
+
+    // STEP 2: Pacing timer, one DREQ per audio sample
+    uint16_t x, y;
+    stream->sample_rate_hz = pwm_stream_pacing_fraction(clock_get_hz(clk_sys), sample_rate_hz, &x, &y);
+    stream->dma_timer = dma_claim_unused_timer(true);
+    dma_timer_set_fraction(stream->dma_timer, x, y);
+
+    // STEP 3: Two channels, each draining one block and then starting
+    // the other. The read ring wraps each channel back to the start of
+    // its block, and the transfer count reloads on every trigger, so the
+    // ping-pong runs with no reprogramming; each channel raises one
+    // interrupt per block.
+    // A 16-bit write to the compare register lands in both halves
+    // (channels A and B of the slice get the same level).
+    stream->dma_channel[0] = dma_claim_unused_channel(true);
+    stream->dma_channel[1] = dma_claim_unused_channel(true);
+
+    for (int i = 0; i < PWM_STREAM_BLOCKS; i++) {
+        int channel = stream->dma_channel[i];
+        int partner = stream->dma_channel[i ^ 1];
+
+        dma_channel_config dma_config = dma_channel_get_default_config(channel);
+        channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_16);
+        channel_config_set_read_increment(&dma_config, true);
+        channel_config_set_write_increment(&dma_config, false);   // Always the compare register
+        channel_config_set_ring(&dma_config, false, PWM_STREAM_BLOCK_BITS + 1);  // Wrap in block (bytes)
+        channel_config_set_dreq(&dma_config, dma_get_timer_dreq(stream->dma_timer));
+        channel_config_set_chain_to(&dma_config, partner);
+
+        dma_channel_configure(channel, &dma_config,
+                              &pwm_hw->slice[stream->slice].cc,  // Write: compare levels
+                              stream->blocks[i],                 // Read: this block
+                              PWM_STREAM_BLOCK_SIZE,             // One block per trigger
+                              false);                            // Don't start yet
+        dma_channel_set_irq0_enabled(channel, true);
+    }
+
+    // STEP 4: Completion interrupt (shared: other code may use DMA_IRQ_0).
+    // dma_claim_unused_timer() above has already failed loudly if a
+    // fifth stream was attempted, so there is always a free entry.
+    register_stream(stream);
+}
+
+void pwm_stream_start(PwmStream* stream) {
+    // Block 0 first; the chain takes it from there
+    prime_blocks(stream);
+    stream->playing = 0;
+    dma_channel_start(stream->dma_channel[0]);
+}
+
+void pwm_stream_stop(PwmStream* stream) {
+    // Abort both at once, so the chain can't restart the one just aborted
+    uint32_t mask = (1u << stream->dma_channel[0]) | (1u << stream->dma_channel[1]);
+    dma_hw->abort = mask;
+    while (dma_hw->abort & mask) {
+        tight_loop_contents();
+    }
+    stream->playing = -1;
+}
+
+#else
+
+// ============================================================
+// HOST STAND-IN
+// ============================================================
+
+#define HOST_CLOCK_HZ 150000000u   // RP2350 default clk_sys
+
+void pwm_stream_init(PwmStream* stream, uint32_t pin, uint16_t top, float sample_rate_hz) {
+    init_blocks(stream, top);
+    stream->slice = pin;
+
+    uint16_t x, y;
+    stream->sample_rate_hz = pwm_stream_pacing_fraction(HOST_CLOCK_HZ, sample_rate_hz, &x, &y);
+}
+
+void pwm_stream_start(PwmStream* stream) {
+    prime_blocks(stream);
+    stream->playing = 0;
+    stream->read_position = 0;
+}
+
+void pwm_stream_stop(PwmStream* stream) {
+    stream->playing = -1;
+}
+
+void pwm_stream_record(PwmStream* stream, uint16_t* buffer, size_t capacity) {
+    stream->recording = buffer;
+    stream->recording_capacity = capacity;
+    stream->recorded = 0;
+}
+
+void pwm_stream_drain(PwmStream* stream, size_t count) {
+    // What the paced, chained DMA channels do, one sample at a time
+    for (size_t i = 0; i < count; i++) {
+        int block = stream->playing;
+        if (block < 0) {
+            return;   // Stopped: the pacing timer isn't triggering anything
+        }
+
+        uint16_t level = stream->blocks[block][stream->read_position++];
+        if (stream->recorded < stream->recording_capacity) {
+            stream->recording[stream->recorded++] = level;
+        }
+
+        // Block drained: the chain starts the other channel and the
+        // completion interrupt runs
+        if (stream->read_position == PWM_STREAM_BLOCK_SIZE) {
+            stream->read_position = 0;
+            block_done(stream, block);
+        }
+    }
+}
+
+#endif
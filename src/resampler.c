@@ -0,0 +1,195 @@
+// resampler.c
+// Implementation of the polyphase sample-rate converter
+
+#include "../include/resampler.h"
+#include <math.h>
+#include <string.h>
+
+// ============================================================
+// QUALITY PRESETS
+// ============================================================
+
+typedef struct {
+    float length;            // Filter length, in samples of the lower rate
+    uint32_t phase_bits;     // log2(stored phases)
+    float rolloff;           // Cutoff (-6 dB) as a fraction of the lower Nyquist
+    float kaiser_beta;       // Window shape: higher = deeper stopband, wider transition
+} ResamplerPreset;
+
+// Kaiser's rule: stopband ≈ 8.7 × beta + 8.7 dB (beta ≥ 4), transition
+// width ≈ (stopband - 8) / (14.4 × length) of the lower rate. The cutoff
+// sits half a transition below Nyquist so the stopband starts close to
+// it. The phase count keeps the lerp between phases below the stopband.
+// Rounding the coefficients to Q15 leaves a floor near -73 dB, so HIGH
+// spends its extra length on a wider passband rather than a deeper
+// stopband (either is past the ~66 dB of the 11-bit PWM output).
+static const ResamplerPreset presets[] = {
+    { 16.0f, 4, 0.78f, 5.0f },    // FAST:   ~50 dB, passband to ~6 kHz at 20 kHz
+    { 24.0f, 5, 0.80f, 7.0f },    // MEDIUM: ~70 dB, to ~6.5 kHz
+    { 40.0f, 6, 0.88f, 7.0f }     // HIGH:   ~70 dB, to ~7.8 kHz
+};
+
+// ============================================================
+// FILTER DESIGN (INIT ONLY)
+// ============================================================
+
+// Modified Bessel function of the first kind, order 0 (power series)
+static double bessel_i0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+// Windowed sinc at offset d input samples from the output time
+static double kernel(double d, double cutoff, double half_width, double beta) {
+    if (fabs(d) >= half_width) {
+        return 0.0;
+    }
+    double x = 2.0 * cutoff * d;
+    double sinc = (fabs(x) < 1e-9) ? 1.0 : sin(M_PI * x) / (M_PI * x);
+    double r = d / half_width;
+    double window = bessel_i0(beta * sqrt(1.0 - r * r)) / bessel_i0(beta);
+    return 2.0 * cutoff * sinc * window;
+}
+
+void resampler_init(Resampler* resampler, float input_rate, float output_rate,
+                    ResamplerQuality quality) {
+    const ResamplerPreset* preset = &presets[quality];
+    double ratio = (double)input_rate / (double)output_rate;
+
+    // STEP 1: Output time step (32.32)
+    resampler->step_int = (uint32_t)ratio;
+    resampler->step_frac = (uint32_t)((ratio - (double)resampler->step_int) * 4294967296.0 + 0.5);
+
+    // STEP 2: Filter size; when downsampling the filter must cover
+    // `length` output samples, i.e. ratio × length input samples
+    double stretch = (ratio > 1.0) ? ratio : 1.0;
+    uint32_t taps = (uint32_t)ceil(preset->length * stretch);
+    taps = (taps + 1) & ~1u;
+    if (taps > RESAMPLER_MAX_TAPS) {
+        taps = RESAMPLER_MAX_TAPS;
+    }
+    resampler->taps = taps;
+    resampler->phase_bits = preset->phase_bits;
+
+    // STEP 3: Coefficients, in cycles per input sample
+    // Row p is the kernel for an output p / phases of a sample after
+    // the tap at taps / 2 - 1; the extra row (p = phases) lets the
+    // lerp reach the next whole sample
+    double cutoff = 0.5 * preset->rolloff / stretch;
+    double half_width = taps / 2;
+    uint32_t phases = 1u << preset->phase_bits;
+
+    for (uint32_t p = 0; p <= phases; p++) {
+        double offset = (double)p / phases;
+        double row[RESAMPLER_MAX_TAPS];
+        double sum = 0.0;
+        for (uint32_t j = 0; j < taps; j++) {
+            row[j] = kernel((double)j - (half_width - 1.0) - offset, cutoff, half_width,
+                            preset->kaiser_beta);
+            sum += row[j];
+        }
+
+        // Every row sums to exactly 1.0 (32768) after rounding, so DC
+        // passes with unity gain at any phase; the rounding residue goes
+        // on the largest tap
+        int32_t total = 0;
+        uint32_t largest = 0;
+        for (uint32_t j = 0; j < taps; j++) {
+            int32_t value = (int32_t)lround(row[j] / sum * 32768.0);
+            resampler->coefficients[p][j] = (int16_t)value;
+            total += value;
+            if (fabs(row[j]) > fabs(row[largest])) {
+                largest = j;
+            }
+        }
+        resampler->coefficients[p][largest] += (int16_t)(32768 - total);
+    }
+
+    resampler_reset(resampler);
+}
+
+void resampler_reset(Resampler* resampler) {
+    // taps / 2 - 1 samples of silence before the first input, which
+    // then sits under the kernel's centre for output 0
+    uint32_t lead = resampler->taps / 2 - 1;
+    memset(resampler->history, 0, sizeof(resampler->history));
+    resampler->filled = lead;
+    resampler->position = lead;
+    resampler->fraction = 0;
+}
+
+// ============================================================
+// CONVERSION
+// ============================================================
+
+static inline int64_t dot(const int16_t* x, const int16_t* h, uint32_t taps) {
+    // Q15 × Q15 → Q30; 64-bit because a sinc's |h| sums to more than 1
+    int64_t acc = 0;
+    for (uint32_t j = 0; j < taps; j++) {
+        acc += (int32_t)x[j] * h[j];
+    }
+    return acc;
+}
+
+size_t resampler_process(Resampler* resampler, const int16_t* in, size_t n_in,
+                         int16_t* out, size_t max_out) {
+    const uint32_t taps = resampler->taps;
+    const uint32_t half = taps / 2;
+    const uint32_t phase_shift = 32 - resampler->phase_bits;
+    size_t written = 0;
+
+    while (n_in > 0) {
+        // STEP 1: Append (up to) a block after the samples still needed
+        size_t chunk = (n_in < RESAMPLER_MAX_BLOCK) ? n_in : RESAMPLER_MAX_BLOCK;
+        memcpy(&resampler->history[resampler->filled], in, chunk * sizeof(int16_t));
+        resampler->filled += (uint32_t)chunk;
+        in += chunk;
+        n_in -= chunk;
+
+        // STEP 2: Every output whose last tap has arrived
+        uint32_t position = resampler->position;
+        uint32_t fraction = resampler->fraction;
+
+        while (position + half < resampler->filled) {
+            const int16_t* x = &resampler->history[position + 1 - half];
+            uint32_t phase = fraction >> phase_shift;
+            int32_t weight = (int32_t)((fraction << resampler->phase_bits) >> 17);   // Q15
+
+            // Filter with the two neighbouring phases and lerp between them
+            int64_t a = dot(x, resampler->coefficients[phase], taps);
+            int64_t b = dot(x, resampler->coefficients[phase + 1], taps);
+            int64_t y = a + (((b - a) * weight) >> 15);
+
+            y = (y + (1 << 14)) >> 15;                 // Q30 → Q15, rounded
+            if (y > 32767) y = 32767;                  // Sinc overshoot on full-scale steps
+            if (y < -32768) y = -32768;
+            if (written < max_out) {
+                out[written++] = (int16_t)y;
+            }
+
+            // Advance the output time (32.32)
+            uint32_t next = fraction + resampler->step_frac;
+            position += resampler->step_int + (next < fraction);
+            fraction = next;
+        }
+
+        // STEP 3: Drop what no later output will touch
+        uint32_t first = position + 1 - half;
+        if (first > resampler->filled) {
+            first = resampler->filled;
+        }
+        resampler->filled -= first;
+        memmove(resampler->history, &resampler->history[first],
+                resampler->filled * sizeof(int16_t));
+        resampler->position = position - first;
+        resampler->fraction = fraction;
+    }
+
+    return written;
+}
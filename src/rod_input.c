@@ -6,6 +6,8 @@
 #include "hardware/timer.h"
 #include "hardware/adc.h"
 #include "hardware/dma.h"
+#include "../include/adc_capture.h"
+#include "../include/freq_counter.h"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -21,13 +23,20 @@ extern float MAX_VOL;
 
 const float STANDARD_FREQUENCY = 4202.3869557909;
 
-extern uint32_t adc_fifo_out = 0;
+// Antenna samples, written by DMA (see adc_capture.h)
+#define ANTENNA_SAMPLE_RATE 50000.0f   // ADC conversions per second
+AdcCapture antenna_capture;
+
+// Antenna oscillator frequency, measured by FC0 in the background
+// (ideal source is a rectangle wave on a clock input pin)
+#define ANTENNA_FC_SRC CLOCKS_FC0_SRC_VALUE_CLKSRC_GPIN0
+FreqCounter antenna_counter;
 
 void init_adc();
 void init_adc_freerun();
 void init_dma();
 void init_input();
-void find_freq();
+float find_freq(void);
 void get_pitch();
 void get_vol();
 
@@ -48,53 +57,34 @@ void init_adc_freerun() {
 }
 
 void init_dma() {
-    dma_channel_get_default_config(0);
-
-    dma_hw -> ch[0].read_addr = (uint32_t)&adc_hw -> fifo;
-    dma_hw -> ch[0].write_addr = (uint32_t)&adc_fifo_out;
-
-    dma_hw -> ch[0].transfer_count = (1u << DMA_CH0_TRANS_COUNT_MODE_LSB) | (1 << DMA_CH0_TRANS_COUNT_COUNT_LSB); // verify this (may not need count_count);
-
-    uint32_t temp = 0;
-    temp |= (1 << DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB); // verify size of each data transfer
-    temp |= (DREQ_ADC << DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB);
-    temp |= (1u << DMA_CH0_CTRL_TRIG_EN_LSB);
-    dma_hw -> ch[0].ctrl_trig = temp;
-
-    // consider setting up dma 
+    // Free-running capture: two chained DMA channels ping-pong between
+    // two blocks, so every conversion is kept (one word used to be
+    // overwritten by each new sample). Blocks come out of
+    // adc_capture_acquire() with no copy.
+    adc_capture_init(&antenna_capture, ADC_CHAN, ANTENNA_SAMPLE_RATE);
 }
 
 void init_input() {
     // init input pin not connected to adc
     gpio_init(VOL_PIN);
 
-    // init input through adc 
+    // init frequency counter on the antenna clock
+    // change to clk_ref to clk_sys for more accuracy (6 MHz to 150 MHz)
+    freq_counter_init(&antenna_counter, &clocks_hw->fc0, ANTENNA_FC_SRC,
+                      clock_get_hz(clk_ref) / 1000);
+
+    // init input through adc (adc_capture sets up the ADC and its FIFO)
     init_dma();
-    init_adc_freerun();
-    adc_fifo_setup(true, true, 1, true, true);
+    adc_capture_start(&antenna_capture);
 }
 
-void find_freq(uint src) {
-    // ideal source is a rectangle wave
-    fc_hw_t *fc = &clocks_hw -> fc0;
-    
-    // wait if fc is already running
-    while(fc -> status & CLOCKS_FC0_STATUS_RUNNING_BITS) {
-        tight_loop_contents();
-    }
-
-    fc -> ref_khz = clock_get_hz(clk_ref) / 1000; // change to clk_ref to clk_sys for more accuracy (6 MHz to 150 MHz)
-    fc -> interval = 15; // The test interval is 0.98us * 2**interval (see table 542 for relationship to accuracy)
-    fc -> min_khz = 0; // min pass freq (triggers pass/fail flag, too much work)
-    fc -> max_khz = 0xffffffff; // max pass freq (triggers pass/fail flag, too much work)
-    fc -> src = src; // sets source, automatically starts measurment
-    
-    // wait til done
-    while(!(fc -> status & CLOCKS_FC0_STATUS_DONE_BITS)) {
-        tight_loop_contents();
-    }
-
-    return fc -> result >> CLOCKS_FC0_RESULT_KHZ_LSB;
+float find_freq(void) {
+    // Latest antenna frequency (Hz), without waiting
+    // The frequency counter used to be started and waited on here
+    // (~32 ms per call at interval 15); now each call only collects a
+    // finished measurement and starts the next (see freq_counter.h)
+    freq_counter_poll(&antenna_counter);
+    return freq_counter_latest(&antenna_counter);
 }
 
 void get_vol() {
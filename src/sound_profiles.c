@@ -5,12 +5,23 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <math.h>
 #include "pico/stdlib.h"        // Pico SDK standard library
 #include "hardware/adc.h"       // RP2040/RP2350 ADC library
+#include "hardware/clocks.h"    // Frequency counter reference clock
+#include "hardware/gpio.h"      // UI buttons and switches
+#include "hardware/uart.h"      // Non-blocking status output
 #include "pico/time.h"          // Time functions
 #include "../include/autotune.h"
 #include "../include/waveform.h"
+#include "../include/control.h"
+#include "../include/adc_capture.h"
+#include "../include/freq_counter.h"
+#include "../include/decimator.h"
+#include "../include/audio_ring.h"
+#include "../include/pwm_stream.h"
+#include "../include/pipeline.h"
 
 // ============================================================
 // CONFIGURATION
@@ -21,45 +32,154 @@
 #define ADC_PIN 26                 // GPIO 26 = ADC0 - UPDATE THIS IF NEEDED
 #define ADC_VREF 3.3f              // ADC reference voltage
 #define ADC_MAX_VALUE 4095         // 12-bit ADC (0-4095)
+#define ADC_TABLE_SIZE (ADC_MAX_VALUE + 1)  // One entry per possible ADC value
 
 // Audio Configuration
 #define AUDIO_BUFFER_SIZE 256      // Number of samples per buffer
 #define SAMPLE_RATE 44100          // Audio sample rate
+#define OUTPUT_GAIN Q15_ONE        // Output level in Q15 (Q15_ONE = full scale)
+
+// PWM Output (same pin and levels as audio_output.c)
+#define PWM_AUDIO_PIN 37           // GPIO with the PWM output
+#define PWM_AUDIO_TOP 2047         // 11-bit levels, ~73 kHz carrier at 150 MHz
 
 // Frequency Range
 #define MIN_FREQUENCY 65.41f       // C2
 #define MAX_FREQUENCY 2093.0f      // C7
 
+// Volume Antenna Configuration
+// The pitch capture keeps the one ADC busy, so the volume antenna's
+// oscillator goes to a clock input and the frequency counter measures
+// it. The hand detunes it as it gets closer.
+// UPDATE THESE FOR YOUR OSCILLATOR (measure with the hand far / near)
+#define VOLUME_FC_SRC CLOCKS_FC0_SRC_VALUE_CLKSRC_GPIN0  // Clock input the oscillator drives
+#define VOLUME_FREQ_FAR 500000.0f  // Hand away from the antenna: full volume (Hz)
+#define VOLUME_FREQ_NEAR 480000.0f // Hand at the antenna: silent (Hz)
+
 // Profile Configuration
 #define PROFILE_AUTOTUNE 0         // Profile index for auto-tune
 #define AUTOTUNE_STRENGTH 1.0f     // 100% correction
-#define AUTOTUNE_GLIDE 0.3f        // Smooth glide rate
+#define AUTOTUNE_GLIDE_MS 15.0f    // Glide time constant (ms), no clicks
+#define AUTOTUNE_DEAD_ZONE 15.0f   // Cents past a note boundary before switching
+#define AUTOTUNE_MIN_DWELL_MS 30.0f  // Shortest time on a note (ms)
+#define AUTOTUNE_VIBRATO_HZ 2.0f   // Keep hand vibrato above this rate (0 = flatten it)
+
+// UI Configuration - UPDATE THESE IF YOUR WIRING IS DIFFERENT
+// Inputs are pulled up: a pressed button / closed switch reads low
+#define PROFILE_BUTTON_FIRST_PIN 15  // Buttons on GPIO 15..18 pick profile 0..3
+#define PROFILE_COUNT 4
+#define LEVEL_SWITCH_FIRST_PIN 28  // Output level switch B0..B3 on GPIO 28..31
+#define LEVEL_SWITCH_BITS 4        // (all open = full level)
+#define LEVEL_MAX ((1u << LEVEL_SWITCH_BITS) - 1)
+#define PROFILE_BUTTON_MASK (((1u << PROFILE_COUNT) - 1) << PROFILE_BUTTON_FIRST_PIN)
+#define LEVEL_SWITCH_MASK (LEVEL_MAX << LEVEL_SWITCH_FIRST_PIN)
+#define UI_DEBOUNCE_US 20000       // Inputs must hold still this long (contact bounce)
+#define UI_INPUTS_UNKNOWN 0xFFFFFFFFu  // Before the first debounced read
+
+// Control Rate Configuration
+// The antennas are read by a timer at CONTROL_RATE, not by the audio loop
+#define CONTROL_DECIMATION 32      // Audio samples per control point
+#define CONTROL_RATE ((float)SAMPLE_RATE / CONTROL_DECIMATION)  // ~1378 readings per second
+#define CONTROL_POINTS_PER_BLOCK (AUDIO_BUFFER_SIZE / CONTROL_DECIMATION)  // 8
+#define CONTROL_SUBSTEPS 4         // Interpolation steps between control points
+
+// Oversampling: the pitch ADC free-runs at CIC_DECIMATION × CONTROL_RATE
+// (~353 ksps) into DMA blocks; each block decimates to one control point
+#define PITCH_ADC_RATE (CONTROL_RATE * CIC_DECIMATION)
+#define STATUS_INTERVAL_US 1000000 // Control core status line period
+
+#if CIC_DECIMATION != ADC_CAPTURE_BLOCK_SIZE
+#error "One DMA block must decimate to exactly one control point"
+#endif
+
+#if AUDIO_BUFFER_SIZE != AUDIO_RING_BLOCK_SIZE
+#error "Audio blocks are rendered straight into the audio ring"
+#endif
+
+#if PWM_STREAM_BLOCK_SIZE != AUDIO_RING_BLOCK_SIZE
+#error "Each audio ring block must fill exactly one PWM block"
+#endif
+#define AUTOTUNE_SCALE SCALE_CHROMATIC  // Scale to snap to (see autotune.h)
+#define AUTOTUNE_ROOT NOTE_C       // Root key of the scale
 
 // ============================================================
 // GLOBAL VARIABLES
 // ============================================================
 
-// Audio output buffer
-int16_t audio_buffer[AUDIO_BUFFER_SIZE];
-
-// Current audio buffer index
-uint16_t buffer_index = 0;
+// Audio output: blocks go synthesis → audio_ring → PWM stream.
+// audio_buffer points at the ring block being rendered (no copies).
+AudioRing audio_ring;
+int16_t* audio_buffer = NULL;
+static PwmStream output_stream;        // Ring consumer (DMA interrupt, core 0)
 
 // Oscillator for waveform generation
 Oscillator oscillator;
 
+// Auto-tune voice (runs on the control points, at CONTROL_RATE)
+AutoTuneState autotune_voice;
+
+// Dual-core split:
+//   core 1 (control): antenna capture → auto-tune → control_ring,
+//                     UI → audio_params, status output
+//   core 0 (audio):   control_ring + audio_params → blocks → audio_ring
+// Each piece of state below is written by one core only.
+ControlRing control_ring;
+AdcCapture pitch_capture;              // Oversampled pitch antenna (DMA, core 1)
+FreqCounter volume_counter;            // Volume antenna oscillator (FC0, core 1)
+Decimator pitch_decimator;             // Blocks → 14+ bit control values (core 1)
+ParamSnapshots audio_params;           // UI settings, core 1 → core 0
+
+// Where the previous block's interpolation ended
+uint32_t last_phase_increment = 0;
+float last_volume = 1.0f;
+
+// ADC value → frequency and → phase increment, built once by
+// build_adc_tables() (the ADC only has 4096 possible values, so the
+// exponential mapping never has to run per sample)
+float adc_frequency_table[ADC_TABLE_SIZE];
+uint32_t adc_increment_table[ADC_TABLE_SIZE];
+
 // Current profile (0 = auto-tune, others would be different effects)
+// and the rest of the UI state; owned by core 1, which publishes it to
+// core 0 through audio_params
 uint8_t current_profile = PROFILE_AUTOTUNE;
+AudioParams ui_params;
+
+// Debounced buttons and level switch (core 1)
+uint32_t ui_inputs = UI_INPUTS_UNKNOWN;   // Last accepted state
+uint32_t ui_pending_inputs = UI_INPUTS_UNKNOWN;  // Last raw read
+uint64_t ui_pending_since = 0;            // When the raw read last changed
+
+// Per-block stats from core 0 (FIFO), for core 1's status line
+uint32_t status_blocks = 0;
+uint32_t status_max_render_us = 0;
+
+// Status line being sent (a few characters per ui_poll(), so core 1
+// never waits on the UART)
+char status_line[128];
+size_t status_length = 0;
+size_t status_sent = 0;
 
 // ============================================================
 // FUNCTION DECLARATIONS
 // ============================================================
 
 void setup_adc(void);
-float read_frequency_from_antenna(void);
+void setup_control_stage(void);
+void control_core_main(void);
+bool control_poll(void);
+void setup_ui(void);
+void ui_poll(void);
+void ui_apply_inputs(uint32_t inputs);
+const char* waveform_name(WaveformType waveform);
+void build_adc_tables(void);
 float adc_value_to_frequency(uint16_t adc_value);
-void process_audio_sample(void);
+float adc_value_to_frequency_oversampled(uint32_t adc_value, uint8_t extra_bits);
+uint32_t adc_value_to_phase_increment(uint16_t adc_value);
+float frequency_to_volume(float frequency);
+void process_audio_block(void);
 void send_buffer_to_partner(void);
+void audio_output_fill(int16_t* samples, size_t count, void* user_data);
 
 // ============================================================
 // MAIN FUNCTION (Pico SDK style)
@@ -91,41 +211,98 @@ int main() {
     
     // STEP 2: Initialize auto-tune system
     autotune_init();
+    scale_set(AUTOTUNE_SCALE, AUTOTUNE_ROOT);
+    AutoTuneConfig autotune_config = AUTOTUNE_DEFAULT_CONFIG;
+    autotune_config.strength = AUTOTUNE_STRENGTH;
+    autotune_config.glide_ms = AUTOTUNE_GLIDE_MS;
+    autotune_config.rate_hz = CONTROL_RATE;
+    autotune_config.dead_zone_cents = AUTOTUNE_DEAD_ZONE;
+    autotune_config.min_dwell_ms = AUTOTUNE_MIN_DWELL_MS;
+    autotune_config.vibrato_cutoff_hz = AUTOTUNE_VIBRATO_HZ;
+    autotune_state_init(&autotune_voice, &autotune_config);
     printf("✓ Auto-tune initialized\n");
     
     // STEP 3: Initialize waveform generation
+    // (tables are const, generated at build time - nothing to compute)
     waveform_init();
-    printf("✓ Waveform tables generated\n");
+    printf("✓ Waveform tables ready (built into flash)\n");
     
     // STEP 4: Initialize oscillator
     // Start with sine wave (Profile 0 uses sine)
     oscillator_init(&oscillator, WAVEFORM_SINE);
+    oscillator_set_interpolation(&oscillator, INTERP_LINEAR);  // No stair-stepping at low notes
     oscillator_set_frequency(&oscillator, 440.0f);  // Start at A4
     printf("✓ Oscillator initialized\n");
     
+    // STEP 5: Start reading the antennas at control rate
+    // (after the ADC tables exist, before the first block needs points)
+    setup_control_stage();
+    printf("✓ Control stage running at %.0f Hz\n", CONTROL_RATE);
+    
+    // STEP 6: Empty audio ring, and the PWM stream that plays it
+    // The stream's DMA completion interrupt (on this core) takes one
+    // ring block per block played; see audio_output_fill(). It starts
+    // once the main loop has filled the ring.
+    audio_ring_init(&audio_ring);
+    pwm_stream_init(&output_stream, PWM_AUDIO_PIN, PWM_AUDIO_TOP, (float)SAMPLE_RATE);
+    pwm_stream_set_noise_shaping(&output_stream, NOISE_SHAPE_SECOND);
+    pwm_stream_set_fill(&output_stream, audio_output_fill, NULL);
+    printf("✓ Audio ring ready (%d blocks), PWM at %.0f Hz\n",
+           AUDIO_RING_BLOCKS, output_stream.sample_rate_hz);
+    
+    // STEP 7: Hand the control side to core 1
+    // Everything it uses is set up above; from here on core 1 owns the
+    // ADC capture, auto-tune and the UI, and core 0 only renders.
+    // Core 1 says READY over the FIFO once it is running.
+    ui_params.profile = current_profile;
+    ui_params.waveform = WAVEFORM_SINE;
+    ui_params.interpolation = INTERP_LINEAR;
+    ui_params.gain = OUTPUT_GAIN;
+    snapshot_init(&audio_params, &ui_params);
+    setup_ui();
+    pipeline_launch_control_core(control_core_main);
+    pipeline_fifo_pop_blocking();
+    printf("✓ Control core running (core 1)\n");
+    
     printf("\n");
     printf("Setup complete! Starting audio generation...\n");
     printf("========================================\n");
     printf("\n");
     
     // ════════════════════════════════════════════════════════
-    // MAIN LOOP - Generate Audio Continuously
+    // MAIN LOOP - Generate Audio Continuously (core 0)
     // ════════════════════════════════════════════════════════
     
+    // No ADC reads, auto-tune or printf here: core 0 only renders
+    bool output_started = false;
     while (true) {
-        // Fill the audio buffer with processed samples
-        // Each buffer contains 256 samples (about 5.8ms of audio at 44.1kHz)
-        for (buffer_index = 0; buffer_index < AUDIO_BUFFER_SIZE; buffer_index++) {
-            // Generate one audio sample with sound profile processing
-            process_audio_sample();
+        // Once the ring is full, start the output (it begins with
+        // AUDIO_RING_BLOCKS blocks of headroom, not with underruns)
+        if (!output_started && audio_ring_space(&audio_ring) == 0) {
+            pwm_stream_start(&output_stream);
+            output_started = true;
+        }
+        
+        // Wait for the PWM stream to free a block (it plays one every
+        // 5.8ms); the ring holds the rest, so nothing is overwritten
+        // while it is still being played
+        while (audio_ring_space(&audio_ring) == 0) {
+            tight_loop_contents();
         }
+        audio_buffer = audio_ring_acquire_write(&audio_ring);
+        
+        // Fill the audio buffer with one block of processed samples
+        // Each buffer contains 256 samples (about 5.8ms of audio at 44.1kHz)
+        uint64_t render_start = time_us_64();
+        process_audio_block();
+        uint32_t render_us = (uint32_t)(time_us_64() - render_start);
         
         // Buffer is full - send to partner for PWM conversion
         send_buffer_to_partner();
         
-        // In a real implementation, you'd wait for partner to finish
-        // processing before filling the next buffer (double buffering)
-        // For now, we just continue immediately
+        // Tell core 1 how long the block took (dropped if its FIFO is
+        // full: stats must never stall the audio)
+        pipeline_fifo_push(PIPELINE_MSG(PIPELINE_MSG_BLOCK, render_us));
     }
     
     return 0;
@@ -154,40 +331,17 @@ void setup_adc(void) {
     // Select which ADC channel to read from
     // This must match the channel corresponding to your GPIO pin
     adc_select_input(ADC_CHANNEL);
-}
-
-// ============================================================
-// READ FREQUENCY FROM ANTENNA
-// ============================================================
-
-float read_frequency_from_antenna(void) {
-    // This function reads the frequency value from your partner's circuit
-    // 
-    // Signal flow:
-    // Hand position → Antenna capacitance → Oscillator frequency →
-    // Frequency-to-voltage converter (your partner's EE circuit) →
-    // Voltage (0-3.3V) → ADC → Digital value (0-4095) → 
-    // Frequency (65-2093 Hz) [this function]
-    
-    // STEP 1: Read raw ADC value
-    // The ADC samples the voltage and returns a 12-bit number (0-4095)
-    // 0 = 0V, 4095 = 3.3V (reference voltage)
-    uint16_t adc_value = adc_read();
-    
-    // STEP 2: Convert ADC value to frequency
-    // Your partner's circuit outputs voltage proportional to pitch
-    // We convert that voltage (represented as ADC value) to frequency in Hz
-    float frequency = adc_value_to_frequency(adc_value);
-    
-    return frequency;
+    
+    // Precompute the ADC → frequency mapping for every ADC value
+    build_adc_tables();
 }
 
 // ============================================================
 // ADC VALUE TO FREQUENCY CONVERSION
 // ============================================================
 
-float adc_value_to_frequency(uint16_t adc_value) {
-    // Convert ADC reading (0-4095) to frequency (65-2093 Hz)
+void build_adc_tables(void) {
+    // Convert every ADC reading (0-4095) to frequency (65-2093 Hz) once
     //
     // We use EXPONENTIAL mapping for musical pitch
     // This is important! Linear mapping would not sound musical.
@@ -203,154 +357,408 @@ float adc_value_to_frequency(uint16_t adc_value) {
     // - C2 (65.41 Hz) to C7 (2093 Hz)
     // - That's 5 octaves (32x frequency range)
     // - log2(2093 / 65.41) = log2(32) = 5 octaves
+    //
+    // This runs once at startup (16 KB per table), so it uses the
+    // accurate exp2f
+    
+    for (int adc_value = 0; adc_value < ADC_TABLE_SIZE; adc_value++) {
+        // STEP 1: Normalize ADC value to 0.0 - 1.0 range
+        // 0 → 0.0 (minimum)
+        // 2047 → 0.5 (middle)
+        // 4095 → 1.0 (maximum)
+        float normalized = (float)adc_value / (float)ADC_MAX_VALUE;
+        
+        // STEP 2: Calculate frequency range in octaves
+        // Our range spans 5 octaves (C2 to C7)
+        float octaves = 5.0f;
+        
+        // STEP 3: Calculate frequency using exponential mapping
+        // This creates a musically-correct pitch response
+        // 
+        // Examples:
+        // normalized = 0.0  → freq = 65.41 × 2^0 = 65.41 Hz (C2)
+        // normalized = 0.2  → freq = 65.41 × 2^1 = 130.8 Hz (C3)
+        // normalized = 0.4  → freq = 65.41 × 2^2 = 261.6 Hz (C4 - middle C)
+        // normalized = 0.6  → freq = 65.41 × 2^3 = 523.2 Hz (C5)
+        // normalized = 0.8  → freq = 65.41 × 2^4 = 1046 Hz (C6)
+        // normalized = 1.0  → freq = 65.41 × 2^5 = 2093 Hz (C7)
+        float frequency = MIN_FREQUENCY * exp2f(normalized * octaves);
+        
+        // STEP 4: Clamp to valid range (safety check)
+        if (frequency < MIN_FREQUENCY) frequency = MIN_FREQUENCY;
+        if (frequency > MAX_FREQUENCY) frequency = MAX_FREQUENCY;
+        
+        // STEP 5: Store it, and the matching oscillator phase increment
+        // at SAMPLE_RATE (same formula as oscillator_set_frequency())
+        adc_frequency_table[adc_value] = frequency;
+        
+        Oscillator probe;
+        oscillator_set_frequency(&probe, frequency);
+        adc_increment_table[adc_value] = probe.phase_increment;
+    }
+}
+
+float adc_value_to_frequency(uint16_t adc_value) {
+    // Convert ADC reading (0-4095) to frequency (65-2093 Hz)
+    // One table read (see build_adc_tables() for the mapping)
     
-    // STEP 1: Normalize ADC value to 0.0 - 1.0 range
-    // 0 → 0.0 (minimum)
-    // 2047 → 0.5 (middle)
-    // 4095 → 1.0 (maximum)
-    float normalized = (float)adc_value / (float)ADC_MAX_VALUE;
+    // In case of ADC noise or errors, ensure we stay in the table
+    if (adc_value > ADC_MAX_VALUE) adc_value = ADC_MAX_VALUE;
     
-    // STEP 2: Calculate frequency range in octaves
-    // Our range spans 5 octaves (C2 to C7)
-    float octaves = 5.0f;
+    return adc_frequency_table[adc_value];
+}
+
+float adc_value_to_frequency_oversampled(uint32_t adc_value, uint8_t extra_bits) {
+    // Same conversion for an oversampled reading: the sum of
+    // 2^extra_bits ADC samples (a 12 + extra_bits bit value)
+    //
+    // The top 12 bits pick the table entry, the extra bits interpolate
+    // toward the next one. Neighbouring entries are only 0.15 cents
+    // apart, so linear interpolation of the exponential curve is exact
+    // for any practical purpose.
+    
+    // STEP 1: Split into table index and fraction
+    uint32_t index = adc_value >> extra_bits;
+    if (index >= ADC_MAX_VALUE) {
+        return adc_frequency_table[ADC_MAX_VALUE];   // Top entry (or beyond)
+    }
+    uint32_t frac_mask = (1u << extra_bits) - 1;
+    float frac = (float)(adc_value & frac_mask) / (float)(1u << extra_bits);
     
-    // STEP 3: Calculate frequency using exponential mapping
-    // This creates a musically-correct pitch response
-    // 
-    // Examples:
-    // normalized = 0.0  → freq = 65.41 × 2^0 = 65.41 Hz (C2)
-    // normalized = 0.2  → freq = 65.41 × 2^1 = 130.8 Hz (C3)
-    // normalized = 0.4  → freq = 65.41 × 2^2 = 261.6 Hz (C4 - middle C)
-    // normalized = 0.6  → freq = 65.41 × 2^3 = 523.2 Hz (C5)
-    // normalized = 0.8  → freq = 65.41 × 2^4 = 1046 Hz (C6)
-    // normalized = 1.0  → freq = 65.41 × 2^5 = 2093 Hz (C7)
-    float frequency = MIN_FREQUENCY * powf(2.0f, normalized * octaves);
-    
-    // STEP 4: Clamp to valid range (safety check)
-    // In case of ADC noise or errors, ensure we stay in bounds
-    if (frequency < MIN_FREQUENCY) frequency = MIN_FREQUENCY;
-    if (frequency > MAX_FREQUENCY) frequency = MAX_FREQUENCY;
-    
-    return frequency;
+    // STEP 2: Interpolate between the two entries
+    float low = adc_frequency_table[index];
+    float high = adc_frequency_table[index + 1];
+    return low + (high - low) * frac;
+}
+
+uint32_t adc_value_to_phase_increment(uint16_t adc_value) {
+    // ADC reading → oscillator phase increment at SAMPLE_RATE, for paths
+    // that play the raw pitch: no oscillator_set_frequency() needed
+    if (adc_value > ADC_MAX_VALUE) adc_value = ADC_MAX_VALUE;
+    
+    return adc_increment_table[adc_value];
 }
 
 // ============================================================
-// PROCESS ONE AUDIO SAMPLE
+// VOLUME ANTENNA
 // ============================================================
 
-void process_audio_sample(void) {
-    // This is the heart of the sound profile system!
-    // This function is called 44,100 times per second (once per audio sample)
-    // It processes the raw frequency through the active sound profile
-    //
-    // Current implementation: Auto-tune profile only
-    // Future: Will handle all 4 profiles (auto-tune, reverb, distortion, delay)
+float frequency_to_volume(float frequency) {
+    // Volume antenna frequency (Hz) → volume (0.0 = silent, 1.0 = full)
+    // Linear between the two calibration points. Loudness is already
+    // roughly logarithmic in hand distance, so this feels even.
+    
+    // No measurement yet: stay silent rather than start at full volume
+    if (!(frequency > 0.0f)) {
+        return 0.0f;
+    }
     
-    // ════════════════════════════════════════════════════════
-    // STEP 1: READ INPUT FREQUENCY
-    // ════════════════════════════════════════════════════════
+    float volume = (frequency - VOLUME_FREQ_NEAR) / (VOLUME_FREQ_FAR - VOLUME_FREQ_NEAR);
+    if (volume < 0.0f) volume = 0.0f;
+    if (volume > 1.0f) volume = 1.0f;
+    return volume;
+}
+
+// ============================================================
+// CONTROL STAGE
+// ============================================================
+
+void setup_control_stage(void) {
+    // The antennas are captured on core 1 (control_core_main()), so ADC
+    // work never sits inside the audio loop.
+    // The ADC clock and the audio clock drift apart slightly; the ring
+    // absorbs that (see control_ring_pop()).
+    ControlPoint initial = { 440.0f, 1.0f };
+    control_ring_init(&control_ring, initial);
+    
+    // The pitch ADC free-runs into DMA blocks from here on (this takes
+    // over the ADC from setup_adc()'s single reads)
+    decimator_init(&pitch_decimator);
+    adc_capture_init(&pitch_capture, ADC_CHANNEL, PITCH_ADC_RATE);
+    adc_capture_start(&pitch_capture);
+    
+    // The volume antenna is measured in the background; control_poll()
+    // collects each result and starts the next without waiting
+    freq_counter_init(&volume_counter, &clocks_hw->fc0, VOLUME_FC_SRC,
+                      clock_get_hz(clk_ref) / 1000);
+    
+    // The first block's interpolation starts from the oscillator as set up
+    last_phase_increment = oscillator.phase_increment;
+    last_volume = initial.volume;
+}
+
+// ============================================================
+// CONTROL CORE (CORE 1)
+// ============================================================
+
+void control_core_main(void) {
+    // Core 1 entry: poll the antenna capture and the UI forever.
+    // A capture block completes every 1 / CONTROL_RATE (~725us) and is
+    // only valid for one more block period, so nothing in this loop may
+    // take longer than that.
+    pipeline_fifo_push_blocking(PIPELINE_MSG(PIPELINE_MSG_READY, 0));
     
-    // Read the current frequency from the antenna via ADC
-    // This is the "raw" frequency based on hand position
-    // It might be slightly off-pitch (e.g., 442.3 Hz instead of 440 Hz)
-    float raw_frequency = read_frequency_from_antenna();
+    while (true) {
+        control_poll();
+        ui_poll();
+    }
+}
+
+bool control_poll(void) {
+    // Turns each new capture block into one auto-tuned control point
+    // Returns: true if a point was queued
+    
+    // STEP 1: Decimate the newest block of pitch readings
+    // The CIC filter averages the block's 256 readings down to one value
+    // with 4 fraction bits (12.4), which the interpolated table lookup
+    // uses; the ADC noise that used to jitter the pitch is mostly gone
+    const uint16_t* block = adc_capture_acquire(&pitch_capture);
+    if (block == NULL) {
+        return false;   // Block still filling: nothing new
+    }
     
-    // ════════════════════════════════════════════════════════
-    // STEP 2: APPLY SOUND PROFILE PROCESSING
-    // ════════════════════════════════════════════════════════
+    uint16_t value;
+    if (decimator_process(&pitch_decimator, block, ADC_CAPTURE_BLOCK_SIZE, &value) == 0) {
+        return false;   // Filter still warming up
+    }
     
-    float corrected_frequency;
+    float raw_frequency = adc_value_to_frequency_oversampled(value, DECIMATOR_EXTRA_BITS);
     
-    // Check which profile is currently active
+    // STEP 2: Apply the sound profile's pitch processing
+    ControlPoint point;
     if (current_profile == PROFILE_AUTOTUNE) {
         // ────────────────────────────────────────────────────
         // PROFILE 0: AUTO-TUNE
         // ────────────────────────────────────────────────────
         // This profile corrects pitch to the nearest musical note
         // Makes the theremin easier to play in tune
-        
-        // Apply auto-tune correction
-        corrected_frequency = process_autotune(
-            raw_frequency,         // Input: Raw frequency from antenna
-            AUTOTUNE_STRENGTH,     // 1.0 = 100% correction (perfect pitch)
-            AUTOTUNE_GLIDE        // 0.3 = smooth glide rate (no clicks)
-        );
-        
-        // Debug output (prints every 0.1 seconds)
-        // Shows raw vs corrected frequency
-        // Remove this in production for better performance
-        static int debug_counter = 0;
-        if (debug_counter++ >= 4410) {  // 4410 samples = 0.1 seconds at 44.1kHz
-            printf("Profile 0 (Auto-Tune) | Raw: %.2f Hz → Corrected: %.2f Hz\n", 
-                   raw_frequency, corrected_frequency);
-            debug_counter = 0;
-        }
-        
+        // Strength and glide time come from the voice's config; the glide
+        // is in milliseconds, so it does not depend on the control rate
+        process_autotune_block(&autotune_voice, &raw_frequency, &point.frequency, 1);
     } else {
-        // ────────────────────────────────────────────────────
-        // OTHER PROFILES: NO AUTO-TUNE
-        // ────────────────────────────────────────────────────
-        // Profiles 1, 2, 3 use natural pitch (no correction)
-        // They apply other effects instead:
-        // - Profile 1: Reverb
-        // - Profile 2: Distortion
-        // - Profile 3: Delay
-        
-        corrected_frequency = raw_frequency;  // Use raw frequency directly
+        // Profiles 1, 2, 3 use natural pitch (no correction); their
+        // effects run on the audio core
+        point.frequency = raw_frequency;
     }
     
-    // ════════════════════════════════════════════════════════
-    // STEP 3: SET OSCILLATOR FREQUENCY
-    // ════════════════════════════════════════════════════════
+    // STEP 3: Volume
+    // A frequency-counter result takes up to 32 ms, so most points
+    // repeat the latest one; the audio core ramps between points, so a
+    // new value never clicks
+    freq_counter_poll(&volume_counter);
+    point.volume = frequency_to_volume(freq_counter_latest(&volume_counter));
+    
+    // STEP 4: Queue it for the audio core
+    control_ring_push(&control_ring, &point);
+    return true;
+}
+
+void setup_ui(void) {
+    // Buttons and level switch: inputs with pull-ups (pressed / closed
+    // pulls a pin low). ui_poll() reads them all in one go.
+    for (uint32_t pin = PROFILE_BUTTON_FIRST_PIN; pin < PROFILE_BUTTON_FIRST_PIN + PROFILE_COUNT; pin++) {
+        gpio_init(pin);
+        gpio_set_dir(pin, GPIO_IN);
+        gpio_pull_up(pin);
+    }
+    for (uint32_t pin = LEVEL_SWITCH_FIRST_PIN; pin < LEVEL_SWITCH_FIRST_PIN + LEVEL_SWITCH_BITS; pin++) {
+        gpio_init(pin);
+        gpio_set_dir(pin, GPIO_IN);
+        gpio_pull_up(pin);
+    }
+}
+
+void ui_poll(void) {
+    // Profile buttons, level switch and the status line
+    // Runs between control points, so nothing here may wait: inputs
+    // are one register read, and the status line goes out a few
+    // characters at a time
+    uint64_t now = time_us_64();
+    
+    // STEP 1: Debounce the buttons and the level switch
+    // A new state counts once it has held still for UI_DEBOUNCE_US
+    uint32_t inputs = gpio_get_all() & (PROFILE_BUTTON_MASK | LEVEL_SWITCH_MASK);
+    if (inputs != ui_pending_inputs) {
+        ui_pending_inputs = inputs;
+        ui_pending_since = now;
+    } else if (inputs != ui_inputs && now - ui_pending_since >= UI_DEBOUNCE_US) {
+        ui_inputs = inputs;
+        ui_apply_inputs(inputs);
+    }
+    
+    // STEP 2: Block stats from the audio core
+    uint32_t message;
+    while (pipeline_fifo_pop(&message)) {
+        if (PIPELINE_MSG_TYPE(message) == PIPELINE_MSG_BLOCK) {
+            status_blocks++;
+            if (PIPELINE_MSG_PAYLOAD(message) > status_max_render_us) {
+                status_max_render_us = PIPELINE_MSG_PAYLOAD(message);
+            }
+        }
+    }
     
-    // Update the oscillator to generate audio at the corrected frequency
-    // This calculates the phase increment needed to produce this frequency
-    oscillator_set_frequency(&oscillator, corrected_frequency);
+    // STEP 3: Send what the UART will take right now (its FIFO holds
+    // 32 characters, ~2.8ms at 115200 baud) without waiting for room
+    while (status_sent < status_length && uart_is_writable(uart_default)) {
+        uart_putc_raw(uart_default, status_line[status_sent++]);
+    }
+    
+    // STEP 4: A new status line once a second (skipped while the last
+    // one is still going out)
+    static uint64_t last_status_time = 0;
+    if (now - last_status_time < STATUS_INTERVAL_US || status_sent < status_length) {
+        return;
+    }
+    last_status_time = now;
+    
+    int length = snprintf(status_line, sizeof(status_line),
+                          "→ Blocks: %u | Slowest: %u us of %u | Underruns: %u | Waveform: %s\r\n",
+                          (unsigned)status_blocks, (unsigned)status_max_render_us,
+                          (unsigned)(1000000u * AUDIO_BUFFER_SIZE / SAMPLE_RATE),
+                          (unsigned)audio_ring.underruns, waveform_name(ui_params.waveform));
+    if (length < 0) length = 0;
+    if ((size_t)length >= sizeof(status_line)) length = sizeof(status_line) - 1;
+    status_length = (size_t)length;
+    status_sent = 0;
+    
+    status_blocks = 0;
+    status_max_render_us = 0;
+}
+
+void ui_apply_inputs(uint32_t inputs) {
+    // Turn a debounced input state into UI settings, and hand them to
+    // core 0 if anything changed (it picks the whole set up at its next
+    // block)
+    AudioParams next = ui_params;
+    
+    // Profile: the lowest pressed button (none pressed: keep the profile)
+    uint32_t pressed = ~inputs & PROFILE_BUTTON_MASK;
+    if (pressed != 0) {
+        next.profile = (uint8_t)(__builtin_ctz(pressed) - PROFILE_BUTTON_FIRST_PIN);
+    }
+    
+    // Output level: the switch is a binary number, a closed switch
+    // clears its bit
+    uint32_t level = (inputs & LEVEL_SWITCH_MASK) >> LEVEL_SWITCH_FIRST_PIN;
+    next.gain = (q15_t)((int32_t)OUTPUT_GAIN * (int32_t)level / (int32_t)LEVEL_MAX);
+    
+    if (next.profile == ui_params.profile && next.gain == ui_params.gain) {
+        return;
+    }
+    
+    ui_params = next;
+    current_profile = next.profile;   // control_poll() runs on this core too
+    snapshot_publish(&audio_params, &ui_params);
+}
+
+const char* waveform_name(WaveformType waveform) {
+    // Waveform name for the status line
+    switch (waveform) {
+        case WAVEFORM_SINE:          return "Sine";
+        case WAVEFORM_SQUARE:        return "Square";
+        case WAVEFORM_SAWTOOTH:      return "Sawtooth";
+        case WAVEFORM_TRIANGLE:      return "Triangle";
+        case WAVEFORM_SQUARE_BLEP:   return "Square (BLEP)";
+        case WAVEFORM_SAWTOOTH_BLEP: return "Sawtooth (BLEP)";
+        case WAVEFORM_TRIANGLE_BLEP: return "Triangle (BLEP)";
+        default:                     return "Unknown";
+    }
+}
+
+// ============================================================
+// PROCESS ONE AUDIO BLOCK
+// ============================================================
+
+void process_audio_block(void) {
+    // This is the heart of the sound profile system!
+    // This function is called once per audio buffer (~172 times per second)
+    // It renders a whole block of AUDIO_BUFFER_SIZE samples from the
+    // control points and settings core 1 has prepared
+    //
+    // Runs on core 0. The antennas, auto-tune and the UI all run on
+    // core 1 (control_core_main()), never here, so the block takes the
+    // same time whatever the ADC or the serial port does.
+    // Each block uses CONTROL_POINTS_PER_BLOCK control points; the
+    // oscillator renders short runs in tight loops and the pitch and
+    // volume are interpolated from one control point to the next.
+    //
+    // Current implementation: Auto-tune profile only
+    // Future: Will handle all 4 profiles (auto-tune, reverb, distortion, delay)
     
     // ════════════════════════════════════════════════════════
-    // STEP 4: GENERATE WAVEFORM SAMPLE
+    // STEP 1: TAKE THIS BLOCK'S CONTROL POINTS
     // ════════════════════════════════════════════════════════
     
-    // Generate one sample of the selected waveform
-    // Returns a float value from -1.0 to +1.0
-    // This represents the amplitude of the wave at this instant
-    float sample_float = oscillator_generate_sample(&oscillator);
+    // Antenna readings from the control core, already through the
+    // sound profile's pitch processing (auto-tune for profile 0)
+    ControlPoint points[CONTROL_POINTS_PER_BLOCK];
+    control_ring_pop(&control_ring, points, CONTROL_POINTS_PER_BLOCK);
     
     // ════════════════════════════════════════════════════════
-    // STEP 5: APPLY ADDITIONAL EFFECTS (FUTURE)
+    // STEP 2: PICK UP THE LATEST SETTINGS
     // ════════════════════════════════════════════════════════
     
-    // TODO: Add effect processing based on active profile:
-    //
-    // if (profile has distortion):
-    //     sample_float = apply_distortion(sample_float, amount);
-    //
-    // if (profile has delay):
-    //     sample_float = apply_delay(sample_float, time, feedback, mix);
-    //
-    // if (profile has reverb):
-    //     sample_float = apply_reverb(sample_float, feedback, mix);
+    // One consistent set per block: a UI change lands between blocks,
+    // never halfway through one
+    const AudioParams* params = snapshot_latest(&audio_params);
+    if (oscillator.waveform_type != params->waveform) {
+        oscillator_set_waveform(&oscillator, params->waveform);
+    }
+    oscillator_set_interpolation(&oscillator, params->interpolation);
     
     // ════════════════════════════════════════════════════════
-    // STEP 6: CONVERT TO INTEGER FORMAT
+    // STEP 3 + 4: INTERPOLATE CONTROLS AND RENDER WAVEFORM
     // ════════════════════════════════════════════════════════
     
-    // Convert float sample (-1.0 to +1.0) to 16-bit integer
-    // This is the format your partner needs for PWM conversion
+    // Each control point covers CONTROL_DECIMATION samples. Over that
+    // span the phase increment and the volume move in CONTROL_SUBSTEPS
+    // straight-line steps from the previous point to this one, so there
+    // are no zipper steps in pitch or level.
     //
-    // Scaling:
-    // -1.0 → -32768 (maximum negative amplitude)
-    //  0.0 →      0 (silence/center)
-    // +1.0 → +32767 (maximum positive amplitude)
-    int16_t sample_int16 = (int16_t)(sample_float * 32767.0f);
+    // Each run renders straight into the output buffer with the integer
+    // (Q15) engine: Q15 table, Q15 interpolation and Q15 gain, no float
+    // round-trip per sample
+    // -32767 .. 0 .. +32767 is the format your partner needs for PWM
+    const int run_length = CONTROL_DECIMATION / CONTROL_SUBSTEPS;
+    int position = 0;
+    
+    for (int i = 0; i < CONTROL_POINTS_PER_BLOCK; i++) {
+        // Phase increment for this point (same formula as always)
+        oscillator_set_frequency(&oscillator, points[i].frequency);
+        int64_t start_increment = (int64_t)last_phase_increment;
+        int64_t end_increment = (int64_t)oscillator.phase_increment;
+        float start_volume = last_volume;
+        float end_volume = points[i].volume;
+        
+        for (int step = 1; step <= CONTROL_SUBSTEPS; step++) {
+            oscillator.phase_increment = (uint32_t)(start_increment
+                + (end_increment - start_increment) * step / CONTROL_SUBSTEPS);
+            float volume = start_volume
+                + (end_volume - start_volume) * (float)step / (float)CONTROL_SUBSTEPS;
+            q15_t gain = (q15_t)((float)params->gain * volume);
+            
+            oscillator_render_block_q15(&oscillator, &audio_buffer[position], run_length, gain);
+            position += run_length;
+        }
+        
+        last_phase_increment = (uint32_t)end_increment;
+        last_volume = end_volume;
+    }
     
     // ════════════════════════════════════════════════════════
-    // STEP 7: STORE IN OUTPUT BUFFER
+    // STEP 5: APPLY ADDITIONAL EFFECTS (FUTURE)
     // ════════════════════════════════════════════════════════
     
-    // Store the processed sample in the output buffer
-    // Once the buffer is full (256 samples), we send it to your partner
-    audio_buffer[buffer_index] = sample_int16;
+    // TODO: Add block effect processing based on active profile:
+    //
+    // if (profile has distortion):
+    //     apply_distortion(audio_buffer, AUDIO_BUFFER_SIZE, amount);
+    //
+    // if (profile has delay):
+    //     apply_delay(audio_buffer, AUDIO_BUFFER_SIZE, time, feedback, mix);
+    //
+    // if (profile has reverb):
+    //     apply_reverb(audio_buffer, AUDIO_BUFFER_SIZE, feedback, mix);
 }
 
 // ============================================================
@@ -372,8 +780,9 @@ void send_buffer_to_partner(void) {
     //    - 256 samples = 5.8ms of audio at 44.1kHz
     //
     // 2. WAVEFORM TYPE (oscillator.waveform_type)
-    //    - Single value: 0, 1, 2, or 3
+    //    - Single value: 0 to 6
     //    - 0 = Sine, 1 = Square, 2 = Sawtooth, 3 = Triangle
+    //    - 4-6 = Square/Sawtooth/Triangle computed with PolyBLEP
     //    - For display/informational purposes
     //
     // ════════════════════════════════════════════════════════
@@ -404,18 +813,46 @@ void send_buffer_to_partner(void) {
     // Common methods:
     
     // ────────────────────────────────────────────────────────
-    // METHOD A: SHARED MEMORY (Same microcontroller)
+    // METHOD A: SHARED MEMORY (Same microcontroller) - IN USE
     // ────────────────────────────────────────────────────────
-    // If you and your partner are both writing code for the same RP2350:
+    // The block is already in audio_ring (process_audio_block() rendered
+    // straight into it); committing it below hands it over. The output
+    // side takes blocks in place (audio_output_fill() does this for the
+    // PWM stream, from its DMA completion interrupt):
     //
-    // extern int16_t* partner_audio_buffer;
-    // extern uint8_t* partner_waveform_type;
-    // extern volatile bool* partner_buffer_ready;
+    // extern AudioRing audio_ring;
     //
-    // memcpy(partner_audio_buffer, audio_buffer, sizeof(audio_buffer));
-    // *partner_waveform_type = oscillator.waveform_type;
-    // *partner_buffer_ready = true;
-    
+    // const int16_t* block = audio_ring_acquire_read(&audio_ring);
+    // if (block != NULL) {
+    //     ... play AUDIO_RING_BLOCK_SIZE samples from block ...
+    //     audio_ring_release_read(&audio_ring);
+    // } else {
+    //     ... play silence (counted in audio_ring.underruns) ...
+    // }
+    //
+    // If the output runs at another rate (the PWM stream in
+    // audio_output.c plays at 20 kHz), convert each block on the way
+    // out rather than rendering at that rate:
+    //
+    // #define PWM_RATE 20000
+    // static Resampler to_pwm;   // resampler_init(&to_pwm, SAMPLE_RATE, PWM_RATE, RESAMPLER_MEDIUM)
+    // static int16_t pending[PWM_STREAM_BLOCK_SIZE];
+    // static size_t pending_count = 0;
+    //
+    // // n_in × output_rate / input_rate + 1 (resampler.h): 117 here
+    // int16_t converted[AUDIO_RING_BLOCK_SIZE * PWM_RATE / SAMPLE_RATE + 1];
+    // size_t n = resampler_process(&to_pwm, block, AUDIO_RING_BLOCK_SIZE,
+    //                              converted, sizeof(converted) / sizeof(converted[0]));
+    //
+    // // A ring block no longer makes a whole PWM block: collect them
+    // for (size_t i = 0; i < n; i++) {
+    //     pending[pending_count++] = converted[i];
+    //     if (pending_count == PWM_STREAM_BLOCK_SIZE) {
+    //         ... pwm_stream_write_block(&stream, pending) ...
+    //         pending_count = 0;
+    //     }
+    // }
+
     // ────────────────────────────────────────────────────────
     // METHOD B: FUNCTION CALL (She provides an API)
     // ────────────────────────────────────────────────────────
@@ -458,39 +895,14 @@ void send_buffer_to_partner(void) {
     //                    AUDIO_BUFFER_SIZE * sizeof(int16_t));
     
     // ════════════════════════════════════════════════════════
-    // CURRENT IMPLEMENTATION: DEBUG OUTPUT
+    // CURRENT IMPLEMENTATION: AUDIO RING
     // ════════════════════════════════════════════════════════
     
-    // For now, just print that we're sending data (for testing)
-    // Get current time in milliseconds
-    static uint64_t last_print_time = 0;
-    uint64_t current_time = to_ms_since_boot(get_absolute_time());
+    // Publish the block to the output side
+    audio_ring_commit_write(&audio_ring);
+    audio_buffer = NULL;
     
-    if (current_time - last_print_time >= 1000) {  // Print once per second
-        printf("→ Buffer ready: %d samples | Waveform: ", AUDIO_BUFFER_SIZE);
-        
-        // Print waveform name instead of number
-        switch (oscillator.waveform_type) {
-            case WAVEFORM_SINE:
-                printf("Sine");
-                break;
-            case WAVEFORM_SQUARE:
-                printf("Square");
-                break;
-            case WAVEFORM_SAWTOOTH:
-                printf("Sawtooth");
-                break;
-            case WAVEFORM_TRIANGLE:
-                printf("Triangle");
-                break;
-            default:
-                printf("Unknown");
-                break;
-        }
-        
-        printf("\n");
-        last_print_time = current_time;
-    }
+    // (The once-a-second status line is sent by core 1: ui_poll())
     
     // ════════════════════════════════════════════════════════
     // TIMING CONSIDERATIONS (FOR PRODUCTION)
@@ -498,19 +910,38 @@ void send_buffer_to_partner(void) {
     
     // In production, you need to handle timing carefully:
     //
-    // 1. DOUBLE BUFFERING:
-    //    - Use two buffers (A and B)
-    //    - While partner processes buffer A, you fill buffer B
-    //    - Swap buffers when both are ready
+    // 1. BUFFERING (done: audio_ring.h)
+    //    - AUDIO_RING_BLOCKS blocks between synthesis and output
+    //    - While partner plays one block, you fill the next
     //    - Prevents audio glitches
     //
-    // 2. SYNCHRONIZATION:
-    //    - Wait for partner to signal "ready for next buffer"
-    //    - Use flags, interrupts, or semaphores
-    //    - Ensure no buffer overruns or underruns
+    // 2. SYNCHRONIZATION (done: audio_ring.h)
+    //    - The main loop waits for a free block before rendering
+    //    - Lock-free: no flags or semaphores to get wrong
+    //    - Overruns and underruns are counted in audio_ring
     //
-    // 3. SAMPLE RATE ACCURACY:
-    //    - Must deliver samples at exactly 44,100 Hz
-    //    - Use timers or DMA for precise timing
-    //    - Jitter causes audio quality issues
+    // 3. SAMPLE RATE ACCURACY (done: pwm_stream.h)
+    //    - A DMA pacing timer writes one sample every 1 / 44,100 s
+    //    - No CPU timing in the loop, so no jitter
+}
+
+// ============================================================
+// AUDIO OUTPUT (RING CONSUMER)
+// ============================================================
+
+void audio_output_fill(int16_t* samples, size_t count, void* user_data) {
+    // Runs in the PWM stream's DMA completion interrupt (core 0), once
+    // per block played: hands it the oldest block in the audio ring,
+    // which frees that block for the main loop
+    (void)user_data;
+    
+    const int16_t* block = audio_ring_acquire_read(&audio_ring);
+    if (block == NULL) {
+        // Nothing rendered in time (counted in audio_ring.underruns)
+        memset(samples, 0, count * sizeof(int16_t));
+        return;
+    }
+    
+    memcpy(samples, block, count * sizeof(int16_t));
+    audio_ring_release_read(&audio_ring);
 }
\ No newline at end of file
@@ -0,0 +1,449 @@
+// tuning.c
+// Implementation of the Scala (.scl / .kbm) tuning loader
+
+#include "../include/tuning.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#if defined(HOST_TEST)
+#include <stdio.h>
+#endif
+
+// ============================================================
+// CONSTANTS
+// ============================================================
+
+#define TUNING_REFERENCE_A4 440.0f   // Pitches are stored relative to A4
+#define MAX_LINE_LENGTH 128          // Longer lines are cut (values come first)
+#define MAX_FILE_SIZE 8192           // Host loader buffer
+
+// Source of Tuning.generation: every build gets a new number
+static uint32_t tuning_generation_counter = 0;
+
+// ============================================================
+// BUILT-IN TUNINGS (FLASH BLOBS)
+// ============================================================
+
+// 5-limit just intonation on C, in plain .scl format
+const char tuning_just_intonation_scl[] =
+    "! just12.scl\n"
+    "!\n"
+    "5-limit just intonation\n"
+    " 12\n"
+    "!\n"
+    " 16/15\n"
+    " 9/8\n"
+    " 6/5\n"
+    " 5/4\n"
+    " 4/3\n"
+    " 45/32\n"
+    " 3/2\n"
+    " 8/5\n"
+    " 5/3\n"
+    " 9/5\n"
+    " 15/8\n"
+    " 2/1\n";
+
+// ============================================================
+// LINE READER
+// ============================================================
+
+// Walks a text buffer one line at a time (\n or \r\n endings)
+typedef struct {
+    const char* text;
+    size_t length;
+    size_t position;
+} LineReader;
+
+// Copy the next non-comment line into line[] (NUL terminated)
+// Lines starting with '!' are comments in both .scl and .kbm
+// Returns: false at the end of the text
+static bool next_line(LineReader* reader, char* line) {
+    while (reader->position < reader->length) {
+        // STEP 1: Find the end of this line
+        size_t start = reader->position;
+        size_t end = start;
+        while (end < reader->length && reader->text[end] != '\n' && reader->text[end] != '\0') {
+            end++;
+        }
+        reader->position = end + 1;
+        if (end < reader->length && reader->text[end] == '\0') {
+            reader->position = reader->length;   // Blob terminator: stop here
+        }
+
+        // STEP 2: Skip comments
+        if (end > start && reader->text[start] == '!') {
+            continue;
+        }
+
+        // STEP 3: Copy, dropping the \r of \r\n
+        size_t count = end - start;
+        if (count > 0 && reader->text[start + count - 1] == '\r') {
+            count--;
+        }
+        if (count > MAX_LINE_LENGTH - 1) {
+            count = MAX_LINE_LENGTH - 1;
+        }
+        memcpy(line, &reader->text[start], count);
+        line[count] = '\0';
+        return true;
+    }
+    return false;
+}
+
+// Same, but skips blank lines (everything after the .scl description)
+static bool next_value_line(LineReader* reader, char* line) {
+    while (next_line(reader, line)) {
+        const char* p = line;
+        while (isspace((unsigned char)*p)) p++;
+        if (*p != '\0') {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Parse the integer at the start of a line
+static bool parse_int(const char* line, int* value) {
+    char* end;
+    long parsed = strtol(line, &end, 10);
+    if (end == line) {
+        return false;
+    }
+    *value = (int)parsed;
+    return true;
+}
+
+// ============================================================
+// SCALA SCALE (.scl)
+// ============================================================
+
+// One .scl pitch line: cents if it has a '.', otherwise a ratio
+// ("3/2", or "2" meaning 2/1). Anything after the value is a label.
+static bool parse_pitch(const char* line, float* ratio) {
+    const char* p = line;
+    while (isspace((unsigned char)*p)) p++;
+
+    // Cents: a '.' inside the value token
+    const char* token_end = p;
+    while (*token_end != '\0' && !isspace((unsigned char)*token_end)) token_end++;
+    const char* dot = memchr(p, '.', (size_t)(token_end - p));
+
+    char* end;
+    if (dot != NULL) {
+        float cents = strtof(p, &end);
+        if (end == p) {
+            return false;
+        }
+        *ratio = exp2f(cents / 1200.0f);
+        return true;
+    }
+
+    // Ratio: numerator, optional /denominator
+    long numerator = strtol(p, &end, 10);
+    if (end == p) {
+        return false;
+    }
+    long denominator = 1;
+    if (*end == '/') {
+        const char* q = end + 1;
+        denominator = strtol(q, &end, 10);
+        if (end == q) {
+            return false;
+        }
+    }
+    if (numerator <= 0 || denominator <= 0) {
+        return false;
+    }
+    *ratio = (float)numerator / (float)denominator;
+    return true;
+}
+
+bool tuning_parse_scl(ScalaScale* scale, const char* text, size_t length) {
+    LineReader reader = { text, length, 0 };
+    char line[MAX_LINE_LENGTH];
+
+    // STEP 1: Description (first non-comment line, may be empty)
+    if (!next_line(&reader, line)) {
+        return false;
+    }
+    strncpy(scale->description, line, sizeof(scale->description) - 1);
+    scale->description[sizeof(scale->description) - 1] = '\0';
+
+    // STEP 2: Number of pitches
+    int count;
+    if (!next_value_line(&reader, line) || !parse_int(line, &count)) {
+        return false;
+    }
+    if (count < 1 || count > MAX_SCALA_DEGREES) {
+        return false;
+    }
+
+    // STEP 3: The pitches themselves
+    for (int i = 0; i < count; i++) {
+        if (!next_value_line(&reader, line) || !parse_pitch(line, &scale->ratios[i])) {
+            return false;
+        }
+    }
+
+    // The period has to go up, or every octave lands on the same notes
+    if (scale->ratios[count - 1] <= 1.0f) {
+        return false;
+    }
+
+    scale->count = count;
+    return true;
+}
+
+// ============================================================
+// KEYBOARD MAPPING (.kbm)
+// ============================================================
+
+void tuning_default_keymap(ScalaKeymap* keymap) {
+    // Linear mapping: every key is the next scale degree,
+    // degree 0 on middle C, A4 at 440 Hz
+    keymap->map_size = 0;
+    keymap->first_note = 0;
+    keymap->last_note = 127;
+    keymap->middle_note = 60;
+    keymap->reference_note = 69;
+    keymap->reference_freq = TUNING_REFERENCE_A4;
+    keymap->octave_degree = 0;
+}
+
+bool tuning_parse_kbm(ScalaKeymap* keymap, const char* text, size_t length) {
+    LineReader reader = { text, length, 0 };
+    char line[MAX_LINE_LENGTH];
+    int header[5];
+
+    // STEP 1: Map size, first note, last note, middle note, reference note
+    for (int i = 0; i < 5; i++) {
+        if (!next_value_line(&reader, line) || !parse_int(line, &header[i])) {
+            return false;
+        }
+    }
+
+    // STEP 2: Reference frequency
+    if (!next_value_line(&reader, line)) {
+        return false;
+    }
+    char* end;
+    float reference_freq = strtof(line, &end);
+    if (end == line || reference_freq <= 0.0f) {
+        return false;
+    }
+
+    // STEP 3: Formal octave degree
+    int octave_degree;
+    if (!next_value_line(&reader, line) || !parse_int(line, &octave_degree)) {
+        return false;
+    }
+
+    keymap->map_size = header[0];
+    keymap->first_note = header[1];
+    keymap->last_note = header[2];
+    keymap->middle_note = header[3];
+    keymap->reference_note = header[4];
+    keymap->reference_freq = reference_freq;
+    keymap->octave_degree = octave_degree;
+
+    if (keymap->map_size < 0 || keymap->map_size > MAX_TUNING_NOTES) {
+        return false;
+    }
+    if (keymap->first_note < 0) keymap->first_note = 0;
+    if (keymap->last_note > MAX_TUNING_NOTES - 1) keymap->last_note = MAX_TUNING_NOTES - 1;
+
+    // STEP 4: One entry per key of the map: a degree, or 'x' for unmapped
+    // Missing trailing entries count as unmapped
+    for (int i = 0; i < keymap->map_size; i++) {
+        int degree;
+        if (!next_value_line(&reader, line)) {
+            keymap->map[i] = KBM_UNMAPPED;
+        } else if (parse_int(line, &degree)) {
+            keymap->map[i] = (int16_t)degree;
+        } else {
+            keymap->map[i] = KBM_UNMAPPED;   // 'x'
+        }
+    }
+
+    return true;
+}
+
+// ============================================================
+// BUILD THE TUNING
+// ============================================================
+
+// Integer division rounding toward minus infinity (keys below the
+// middle note are in negative octaves)
+static inline int floor_div(int a, int b) {
+    int q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+// Ratio of a scale degree (any integer, negative = below degree 0)
+static float degree_ratio(const ScalaScale* scale, int degree) {
+    int period = floor_div(degree, scale->count);
+    int step = degree - period * scale->count;
+    float ratio = (step == 0) ? 1.0f : scale->ratios[step - 1];
+    return ratio * powf(scale->ratios[scale->count - 1], (float)period);
+}
+
+// Scale degree played by a MIDI key
+// Returns: false if the key is unmapped
+static bool key_degree(const ScalaKeymap* keymap, int key, int* degree) {
+    int offset = key - keymap->middle_note;
+    if (keymap->map_size == 0) {
+        *degree = offset;
+        return true;
+    }
+
+    int repeat = floor_div(offset, keymap->map_size);
+    int entry = keymap->map[offset - repeat * keymap->map_size];
+    if (entry == KBM_UNMAPPED) {
+        return false;
+    }
+    *degree = entry + repeat * keymap->octave_degree;
+    return true;
+}
+
+bool tuning_build(Tuning* tuning, const ScalaScale* scale, const ScalaKeymap* keymap,
+                  float min_freq, float max_freq) {
+    ScalaKeymap linear;
+    if (keymap == NULL) {
+        tuning_default_keymap(&linear);
+        keymap = &linear;
+    }
+
+    // STEP 1: Ratio of the reference key, so it lands on reference_freq
+    // (an unmapped reference key falls back to the linear degree)
+    int reference_degree;
+    if (!key_degree(keymap, keymap->reference_note, &reference_degree)) {
+        reference_degree = keymap->reference_note - keymap->middle_note;
+    }
+    float base = keymap->reference_freq / degree_ratio(scale, reference_degree);
+
+    // STEP 2: Frequency of every mapped key in range
+    int count = 0;
+    for (int key = keymap->first_note; key <= keymap->last_note; key++) {
+        int degree;
+        if (!key_degree(keymap, key, &degree)) {
+            continue;
+        }
+        float freq = base * degree_ratio(scale, degree);
+        if (freq < min_freq || freq > max_freq) {
+            continue;
+        }
+
+        // Insertion sort: .scl pitches don't have to be ascending, and
+        // this runs once per load
+        int i = count;
+        while (i > 0 && tuning->freqs[i - 1] > freq) {
+            tuning->freqs[i] = tuning->freqs[i - 1];
+            i--;
+        }
+        tuning->freqs[i] = freq;
+        count++;
+    }
+
+    // No note in range: reject, leaving the tuning as it was (nothing
+    // has been written to it yet)
+    if (count == 0) {
+        return false;
+    }
+
+    // STEP 3: Drop duplicates (two keys on the same pitch)
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique == 0 || tuning->freqs[i] > tuning->freqs[unique - 1] * 1.0001f) {
+            tuning->freqs[unique++] = tuning->freqs[i];
+        }
+    }
+
+    // STEP 4: Precompute what quantization needs, so the audio path
+    // never calls log or sqrt:
+    // - pitch of each note (semitones from A4) for the glide
+    // - boundary to the next note: the geometric mean (midpoint in cents)
+    for (int i = 0; i < unique; i++) {
+        tuning->pitches[i] = 12.0f * log2f(tuning->freqs[i] / TUNING_REFERENCE_A4);
+        tuning->bounds[i] = (i < unique - 1)
+            ? sqrtf(tuning->freqs[i] * tuning->freqs[i + 1])
+            : INFINITY;
+    }
+
+    tuning->count = unique;
+    tuning->generation = ++tuning_generation_counter;
+    return true;
+}
+
+// ============================================================
+// QUANTIZATION
+// ============================================================
+
+int tuning_nearest_index(const Tuning* tuning, float freq) {
+    // Binary search for the first boundary above freq: the note below
+    // that boundary is the nearest in cents.
+    // 128 notes = 7 comparisons.
+    if (tuning->count <= 0) {
+        return 0;   // Never built (tuning_build() never makes an empty one)
+    }
+
+    int low = 0;
+    int high = tuning->count - 1;
+
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (freq < tuning->bounds[mid]) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return low;
+}
+
+float tuning_nearest(const Tuning* tuning, float freq) {
+    if (tuning->count <= 0) {
+        return freq;   // No notes: leave the frequency alone
+    }
+    return tuning->freqs[tuning_nearest_index(tuning, freq)];
+}
+
+// ============================================================
+// HOST FILE LOADING
+// ============================================================
+
+#if defined(HOST_TEST)
+
+// Read a whole text file into buffer (NUL terminated)
+// Returns: number of bytes, or -1 on error
+static long read_text_file(const char* path, char* buffer, size_t size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return -1;
+    }
+    size_t length = fread(buffer, 1, size - 1, file);
+    bool failed = ferror(file) != 0;
+    fclose(file);
+    if (failed) {
+        return -1;
+    }
+    buffer[length] = '\0';
+    return (long)length;
+}
+
+bool tuning_load_scl_file(ScalaScale* scale, const char* path) {
+    static char buffer[MAX_FILE_SIZE];
+    long length = read_text_file(path, buffer, sizeof(buffer));
+    return length >= 0 && tuning_parse_scl(scale, buffer, (size_t)length);
+}
+
+bool tuning_load_kbm_file(ScalaKeymap* keymap, const char* path) {
+    static char buffer[MAX_FILE_SIZE];
+    long length = read_text_file(path, buffer, sizeof(buffer));
+    return length >= 0 && tuning_parse_kbm(keymap, buffer, (size_t)length);
+}
+
+#endif
@@ -5,56 +5,26 @@
 #include <math.h>
 
 // ============================================================
-// GLOBAL WAVETABLES
+// WAVETABLES
 // ============================================================
 
-// These tables store one complete cycle of each waveform
-// We pre-calculate them once and then just look up values
-float sine_table[WAVETABLE_SIZE];
-float square_table[WAVETABLE_SIZE];
-float sawtooth_table[WAVETABLE_SIZE];
-float triangle_table[WAVETABLE_SIZE];
+// sine_table, triangle_table, square_table and sawtooth_table are const
+// tables generated at build time (tools/gen_wavetables.py -> wavetables.c)
+
+static inline int16_t float_to_q15(float value) {
+    // Round to nearest and saturate to -32767..+32767
+    float scaled = value * 32767.0f;
+    if (scaled > 32767.0f) scaled = 32767.0f;
+    if (scaled < -32767.0f) scaled = -32767.0f;
+    return (int16_t)lrintf(scaled);
+}
 
 // ============================================================
 // INITIALIZATION
 // ============================================================
 
 void waveform_init(void) {
-    // Fill all the wavetables with pre-calculated values
-    // This is done once at startup for efficiency
-    
-    for (int i = 0; i < WAVETABLE_SIZE; i++) {
-        // Calculate position in the cycle (0.0 to 1.0)
-        float position = (float)i / (float)WAVETABLE_SIZE;
-        
-        // SINE WAVE
-        // Use the standard sine function
-        // Position 0.0 to 1.0 maps to 0 to 2π radians
-        float angle = position * 2.0f * M_PI;
-        sine_table[i] = sinf(angle);
-        
-        // SQUARE WAVE
-        // First half of cycle = +1.0, second half = -1.0
-        if (i < WAVETABLE_SIZE / 2) {
-            square_table[i] = 1.0f;
-        } else {
-            square_table[i] = -1.0f;
-        }
-        
-        // SAWTOOTH WAVE
-        // Ramps from -1.0 to +1.0 linearly
-        sawtooth_table[i] = (position * 2.0f) - 1.0f;
-        
-        // TRIANGLE WAVE
-        // Ramps up to halfway, then ramps down
-        if (i < WAVETABLE_SIZE / 2) {
-            // First half: ramp up from -1.0 to +1.0
-            triangle_table[i] = (position * 4.0f) - 1.0f;
-        } else {
-            // Second half: ramp down from +1.0 to -1.0
-            triangle_table[i] = 3.0f - (position * 4.0f);
-        }
-    }
+    // Nothing to do: the tables are built into the firmware image
 }
 
 // ============================================================
@@ -66,6 +36,7 @@ void oscillator_init(Oscillator* osc, WaveformType type) {
     osc->phase = 0;              // Start at beginning of waveform
     osc->phase_increment = 0;    // No frequency yet
     osc->waveform_type = type;   // Set waveform type
+    osc->interpolation = INTERP_NONE; // Plain table lookup by default
 }
 
 void oscillator_set_frequency(Oscillator* osc, float frequency) {
@@ -87,7 +58,13 @@ void oscillator_set_frequency(Oscillator* osc, float frequency) {
     // This means we advance through 42,854,614 "steps" of the 2^32 total
     // steps each sample, completing exactly 440 cycles per second!
     
-    float cycles_per_sample = frequency / (float)SAMPLE_RATE;
+    oscillator_set_frequency_rate(osc, frequency, SAMPLE_RATE);
+}
+
+void oscillator_set_frequency_rate(Oscillator* osc, float frequency, uint32_t sample_rate) {
+    // Same formula with the caller's sample rate:
+    // phase_increment = (frequency / sample_rate) × 2^32
+    float cycles_per_sample = frequency / (float)sample_rate;
     osc->phase_increment = (uint32_t)(cycles_per_sample * PHASE_SCALE);
 }
 
@@ -96,43 +73,436 @@ void oscillator_set_waveform(Oscillator* osc, WaveformType type) {
     osc->waveform_type = type;
 }
 
+void oscillator_set_interpolation(Oscillator* osc, InterpolationMode mode) {
+    // Change how samples between table entries are calculated
+    osc->interpolation = mode;
+}
+
+int waveform_mipmap_level(uint32_t phase_increment) {
+    // Level k is alias-free while phase_increment < 2^(24 + k), so the
+    // level is just the bit length of the increment minus 24
+    if (phase_increment < (1u << MIPMAP_BASE_SHIFT)) {
+        return 0;
+    }
+    
+    int bit_length = 32 - __builtin_clz(phase_increment);
+    int level = bit_length - MIPMAP_BASE_SHIFT;
+    
+    return (level < MIPMAP_LEVELS) ? level : MIPMAP_LEVELS - 1;
+}
+
+static const int16_t* select_table(WaveformType type, uint32_t phase_increment) {
+    // Pick the wavetable for a waveform type (and, for the band-limited
+    // waveforms, the mipmap level for this pitch)
+    // Returns NULL for unknown types (caller outputs silence)
+    switch (type) {
+        case WAVEFORM_SINE:     return sine_table;
+        case WAVEFORM_SQUARE:   return square_table[waveform_mipmap_level(phase_increment)];
+        case WAVEFORM_SAWTOOTH: return sawtooth_table[waveform_mipmap_level(phase_increment)];
+        case WAVEFORM_TRIANGLE: return triangle_table;
+        default:                return NULL;
+    }
+}
+
+// ============================================================
+// TABLE LOOKUP (WITH INTERPOLATION)
+// ============================================================
+
+// All lookups split the phase in fixed point:
+//   index = top 8 bits, frac = next 16 bits (Q16, 0..65535)
+// Neighbouring indices wrap with WAVETABLE_MASK, so no bounds checks.
+//
+// The float lookups blend in the table's integer units and scale by
+// Q15_TO_FLOAT once at the end. The Q15 lookups never touch float.
+
+#define FRAC_Q16_TO_FLOAT (1.0f / 65536.0f)
+
+static inline float lookup_none(const int16_t* table, uint32_t phase) {
+    return (float)table[phase >> PHASE_INDEX_SHIFT] * Q15_TO_FLOAT;
+}
+
+static inline float lookup_linear(const int16_t* table, uint32_t phase) {
+    uint32_t index = phase >> PHASE_INDEX_SHIFT;
+    uint32_t frac = (phase >> PHASE_FRAC_SHIFT) & 0xFFFF;
+    
+    float a = table[index];
+    float b = table[(index + 1) & WAVETABLE_MASK];
+    
+    return (a + (b - a) * ((float)frac * FRAC_Q16_TO_FLOAT)) * Q15_TO_FLOAT;
+}
+
+static inline float lookup_hermite(const int16_t* table, uint32_t phase) {
+    // 4-point, 3rd-order Hermite (Catmull-Rom) through
+    // table[i-1], table[i], table[i+1], table[i+2]
+    uint32_t index = phase >> PHASE_INDEX_SHIFT;
+    float t = (float)((phase >> PHASE_FRAC_SHIFT) & 0xFFFF) * FRAC_Q16_TO_FLOAT;
+    
+    float xm1 = table[(index - 1) & WAVETABLE_MASK];
+    float x0  = table[index];
+    float x1  = table[(index + 1) & WAVETABLE_MASK];
+    float x2  = table[(index + 2) & WAVETABLE_MASK];
+    
+    float c1 = 0.5f * (x1 - xm1);
+    float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+    float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+    
+    return (((c3 * t + c2) * t + c1) * t + x0) * Q15_TO_FLOAT;
+}
+
+static inline float lookup(const int16_t* table, uint32_t phase, InterpolationMode mode) {
+    switch (mode) {
+        case INTERP_LINEAR:  return lookup_linear(table, phase);
+        case INTERP_HERMITE: return lookup_hermite(table, phase);
+        default:             return lookup_none(table, phase);
+    }
+}
+
+static inline q15_t saturate_q15(int32_t value) {
+    if (value > Q15_ONE) return Q15_ONE;
+    if (value < -Q15_ONE) return -Q15_ONE;
+    return (q15_t)value;
+}
+
+static inline q15_t lookup_none_q15(const int16_t* table, uint32_t phase) {
+    return table[phase >> PHASE_INDEX_SHIFT];
+}
+
+static inline q15_t lookup_linear_q15(const int16_t* table, uint32_t phase) {
+    // Fraction as Q15 so (b - a) * frac fits in 32 bits
+    uint32_t index = phase >> PHASE_INDEX_SHIFT;
+    int32_t frac = (int32_t)((phase >> (PHASE_FRAC_SHIFT + 1)) & 0x7FFF);
+    
+    int32_t a = table[index];
+    int32_t b = table[(index + 1) & WAVETABLE_MASK];
+    
+    return (q15_t)(a + (((b - a) * frac) >> 15));
+}
+
+static inline q15_t lookup_hermite_q15(const int16_t* table, uint32_t phase) {
+    // Same polynomial as lookup_hermite(), Horner form in Q15
+    // The coefficients reach ~2^17, so the products use 64-bit (one SMULL)
+    uint32_t index = phase >> PHASE_INDEX_SHIFT;
+    int64_t t = (int64_t)((phase >> (PHASE_FRAC_SHIFT + 1)) & 0x7FFF);
+    
+    int32_t xm1 = table[(index - 1) & WAVETABLE_MASK];
+    int32_t x0  = table[index];
+    int32_t x1  = table[(index + 1) & WAVETABLE_MASK];
+    int32_t x2  = table[(index + 2) & WAVETABLE_MASK];
+    
+    int32_t c1 = (x1 - xm1) >> 1;
+    int32_t c2 = xm1 - ((5 * x0) >> 1) + 2 * x1 - (x2 >> 1);
+    int32_t c3 = ((x2 - xm1) >> 1) + ((3 * (x0 - x1)) >> 1);
+    
+    int32_t value = (int32_t)((c3 * t) >> 15) + c2;
+    value = (int32_t)((value * t) >> 15) + c1;
+    value = (int32_t)((value * t) >> 15) + x0;
+    
+    // Can overshoot slightly on hard edges
+    return saturate_q15(value);
+}
+
+static inline q15_t lookup_q15(const int16_t* table, uint32_t phase, InterpolationMode mode) {
+    switch (mode) {
+        case INTERP_LINEAR:  return lookup_linear_q15(table, phase);
+        case INTERP_HERMITE: return lookup_hermite_q15(table, phase);
+        default:             return lookup_none_q15(table, phase);
+    }
+}
+
+// ============================================================
+// ANALYTIC (POLYBLEP) WAVEFORMS
+// ============================================================
+
+// A naive square/saw/triangle computed from the phase aliases because of
+// its hard edges. PolyBLEP adds a 2-sample polynomial residual around each
+// step (and PolyBLAMP around each corner) that approximates the difference
+// between the band-limited and the naive waveform.
+//
+// t  = phase as a fraction of a cycle (0.0 to 1.0)
+// dt = phase increment as a fraction of a cycle
+
+#define PHASE_TO_UNIT (1.0f / 16777216.0f)   // (phase >> 8) / 2^24
+
+static inline int is_blep(WaveformType type) {
+    return type >= WAVEFORM_SQUARE_BLEP && type <= WAVEFORM_TRIANGLE_BLEP;
+}
+
+static inline float phase_to_unit(uint32_t phase) {
+    // Drop the low 8 bits so the value fits exactly in a float mantissa
+    return (float)(phase >> 8) * PHASE_TO_UNIT;
+}
+
+static inline float poly_blep(float t, float dt) {
+    // Residual of a +2 step at t = 0 (from -1 to +1)
+    if (t < dt) {
+        float x = t / dt;                // 0..1 samples after the step
+        return x + x - x * x - 1.0f;     // -(1 - x)^2
+    }
+    if (t > 1.0f - dt) {
+        float x = (t - 1.0f) / dt;       // -1..0 samples before the step
+        return x * x + x + x + 1.0f;     // (x + 1)^2
+    }
+    return 0.0f;
+}
+
+static inline float poly_blamp(float t, float dt) {
+    // Residual of a corner at t = 0 whose slope rises by 1 per sample
+    // (integral of half the BLEP residual above)
+    if (t < dt) {
+        float x = 1.0f - t / dt;
+        return x * x * x * (1.0f / 6.0f);   // (1 - x)^3 / 6
+    }
+    if (t > 1.0f - dt) {
+        float x = (t - 1.0f) / dt + 1.0f;
+        return x * x * x * (1.0f / 6.0f);   // (x + 1)^3 / 6
+    }
+    return 0.0f;
+}
+
+static inline float blep_sawtooth(uint32_t phase, float dt) {
+    // Ramps -1.0 to +1.0, steps down by 2 at the wrap
+    float t = phase_to_unit(phase);
+    return (2.0f * t - 1.0f) - poly_blep(t, dt);
+}
+
+static inline float blep_square(uint32_t phase, float dt) {
+    // +1.0 first half, -1.0 second half: step up at 0, down at 0.5
+    float t = phase_to_unit(phase);
+    float t_half = phase_to_unit(phase + 0x80000000u);
+    float naive = (phase < 0x80000000u) ? 1.0f : -1.0f;
+    return naive + poly_blep(t, dt) - poly_blep(t_half, dt);
+}
+
+static inline float blep_triangle(uint32_t phase, float dt) {
+    // Same shape as triangle_table. The slope changes by +/-8 per cycle
+    // (= 8 * dt per sample) at the corners at 0 and 0.5
+    float t = phase_to_unit(phase);
+    float t_half = phase_to_unit(phase + 0x80000000u);
+    float naive = (phase < 0x80000000u) ? (4.0f * t - 1.0f) : (3.0f - 4.0f * t);
+    return naive + 8.0f * dt * (poly_blamp(t, dt) - poly_blamp(t_half, dt));
+}
+
+static inline float blep_sample(WaveformType type, uint32_t phase, float dt) {
+    switch (type) {
+        case WAVEFORM_SQUARE_BLEP:   return blep_square(phase, dt);
+        case WAVEFORM_SAWTOOTH_BLEP: return blep_sawtooth(phase, dt);
+        default:                     return blep_triangle(phase, dt);
+    }
+}
+
+// ============================================================
+// SAMPLE GENERATION
+// ============================================================
+
 float oscillator_generate_sample(Oscillator* osc) {
     // Generate one audio sample from the oscillator
     
-    // STEP 1: Convert phase (32-bit) to wavetable index (0-255)
-    // We take the top 8 bits of the 32-bit phase
-    // This gives us a value from 0 to 255
-    uint8_t table_index = (osc->phase >> 24) & 0xFF;
+    float sample;
     
-    // STEP 2: Look up the sample value from the appropriate table
-    float sample = 0.0f;
+    if (is_blep(osc->waveform_type)) {
+        // Analytic waveform straight from the phase
+        sample = blep_sample(osc->waveform_type, osc->phase,
+                             phase_to_unit(osc->phase_increment));
+    } else {
+        // STEP 1: Pick the table for this waveform and pitch
+        const int16_t* table = select_table(osc->waveform_type, osc->phase_increment);
+        
+        // STEP 2: Look up the sample value at the current phase
+        // The top 8 bits of the 32-bit phase give the table index (0-255),
+        // the next 16 bits are used by the interpolation modes
+        sample = (table != NULL) ? lookup(table, osc->phase, osc->interpolation) : 0.0f;
+    }
+    
+    // STEP 3: Advance the phase for next sample
+    // This automatically wraps around when it exceeds 2^32
+    osc->phase += osc->phase_increment;
     
-    switch (osc->waveform_type) {
-        case WAVEFORM_SINE:
-            sample = sine_table[table_index];
+    // STEP 4: Return the sample
+    return sample;
+}
+
+q15_t oscillator_generate_sample_q15(Oscillator* osc) {
+    // Integer version of oscillator_generate_sample()
+    
+    q15_t sample;
+    
+    if (is_blep(osc->waveform_type)) {
+        // The analytic waveforms are float math, convert at the end
+        sample = float_to_q15(blep_sample(osc->waveform_type, osc->phase,
+                                          phase_to_unit(osc->phase_increment)));
+    } else {
+        const int16_t* table = select_table(osc->waveform_type, osc->phase_increment);
+        sample = (table != NULL) ? lookup_q15(table, osc->phase, osc->interpolation) : 0;
+    }
+    
+    osc->phase += osc->phase_increment;
+    
+    return sample;
+}
+
+// ============================================================
+// BLOCK RENDERING
+// ============================================================
+
+// One loop per interpolation mode, so the mode is decided once per block
+// and the inner loop has no branches
+static void render_float(const int16_t* table, uint32_t phase, uint32_t increment,
+                         InterpolationMode mode, float* out, size_t n) {
+    switch (mode) {
+        case INTERP_LINEAR:
+            for (size_t i = 0; i < n; i++) {
+                out[i] = lookup_linear(table, phase);
+                phase += increment;
+            }
             break;
             
-        case WAVEFORM_SQUARE:
-            sample = square_table[table_index];
+        case INTERP_HERMITE:
+            for (size_t i = 0; i < n; i++) {
+                out[i] = lookup_hermite(table, phase);
+                phase += increment;
+            }
             break;
             
-        case WAVEFORM_SAWTOOTH:
-            sample = sawtooth_table[table_index];
+        default:
+            for (size_t i = 0; i < n; i++) {
+                out[i] = lookup_none(table, phase);
+                phase += increment;
+            }
+            break;
+    }
+}
+
+// One loop per analytic waveform, for the same reason
+static void render_blep(WaveformType type, uint32_t phase, uint32_t increment,
+                        float* out, size_t n) {
+    float dt = phase_to_unit(increment);
+    
+    switch (type) {
+        case WAVEFORM_SQUARE_BLEP:
+            for (size_t i = 0; i < n; i++) {
+                out[i] = blep_square(phase, dt);
+                phase += increment;
+            }
             break;
             
-        case WAVEFORM_TRIANGLE:
-            sample = triangle_table[table_index];
+        case WAVEFORM_SAWTOOTH_BLEP:
+            for (size_t i = 0; i < n; i++) {
+                out[i] = blep_sawtooth(phase, dt);
+                phase += increment;
+            }
             break;
             
         default:
-            sample = 0.0f;  // Silence if unknown type
+            for (size_t i = 0; i < n; i++) {
+                out[i] = blep_triangle(phase, dt);
+                phase += increment;
+            }
             break;
     }
+}
+
+void oscillator_render_block(Oscillator* osc, float* out, size_t n) {
+    // Same math as oscillator_generate_sample(), but the table, the mipmap
+    // level and the interpolation mode are selected ONCE for the whole
+    // block instead of once per sample.
     
-    // STEP 3: Advance the phase for next sample
-    // This automatically wraps around when it exceeds 2^32
-    osc->phase += osc->phase_increment;
+    const int16_t* table = select_table(osc->waveform_type, osc->phase_increment);
     
-    // STEP 4: Return the sample
-    return sample;
-}
\ No newline at end of file
+    if (is_blep(osc->waveform_type)) {
+        render_blep(osc->waveform_type, osc->phase, osc->phase_increment, out, n);
+    } else if (table == NULL) {
+        // Unknown waveform: silence, but keep the phase moving
+        for (size_t i = 0; i < n; i++) {
+            out[i] = 0.0f;
+        }
+    } else {
+        render_float(table, osc->phase, osc->phase_increment,
+                     osc->interpolation, out, n);
+    }
+    
+    osc->phase += (uint32_t)n * osc->phase_increment;
+}
+
+// Q15 version of render_float()
+static void render_q15(const int16_t* table, uint32_t phase, uint32_t increment,
+                       InterpolationMode mode, q15_t* out, size_t n) {
+    switch (mode) {
+        case INTERP_LINEAR:
+            for (size_t i = 0; i < n; i++) {
+                out[i] = lookup_linear_q15(table, phase);
+                phase += increment;
+            }
+            break;
+            
+        case INTERP_HERMITE:
+            for (size_t i = 0; i < n; i++) {
+                out[i] = lookup_hermite_q15(table, phase);
+                phase += increment;
+            }
+            break;
+            
+        default:
+            for (size_t i = 0; i < n; i++) {
+                out[i] = lookup_none_q15(table, phase);
+                phase += increment;
+            }
+            break;
+    }
+}
+
+static void render_blep_q15(WaveformType type, uint32_t phase, uint32_t increment,
+                            q15_t* out, size_t n) {
+    // The analytic waveforms are float math: render in small float chunks
+    // (fixed stack cost) and convert with saturation, since PolyBLEP can
+    // overshoot slightly on hard edges
+    float chunk[64];
+    
+    while (n > 0) {
+        size_t count = (n < 64) ? n : 64;
+        
+        render_blep(type, phase, increment, chunk, count);
+        for (size_t i = 0; i < count; i++) {
+            out[i] = float_to_q15(chunk[i]);
+        }
+        
+        phase += (uint32_t)count * increment;
+        out += count;
+        n -= count;
+    }
+}
+
+void oscillator_render_block_q15(Oscillator* osc, q15_t* out, size_t n, q15_t gain) {
+    // Integer pipeline: Q15 table -> Q15 interpolation -> Q15 gain
+    // Table path has no float at all, output goes straight to the caller's
+    // int16 buffer
+    
+    const int16_t* table = select_table(osc->waveform_type, osc->phase_increment);
+    
+    if (is_blep(osc->waveform_type)) {
+        render_blep_q15(osc->waveform_type, osc->phase, osc->phase_increment, out, n);
+    } else if (table == NULL) {
+        // Unknown waveform: silence, but keep the phase moving
+        for (size_t i = 0; i < n; i++) {
+            out[i] = 0;
+        }
+    } else {
+        render_q15(table, osc->phase, osc->phase_increment,
+                   osc->interpolation, out, n);
+    }
+    
+    // Gain as a separate pass (skipped at full scale) so the render loops
+    // above stay as simple as possible
+    if (gain != Q15_ONE) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = (q15_t)(((int32_t)out[i] * gain) >> 15);
+        }
+    }
+    
+    osc->phase += (uint32_t)n * osc->phase_increment;
+}
+
+void oscillator_render_block_int16(Oscillator* osc, int16_t* out, size_t n) {
+    // Block render straight into 16-bit audio format at full scale
+    // (-1.0..+1.0 -> -32767..+32767), via the integer pipeline
+    oscillator_render_block_q15(osc, out, n, Q15_ONE);
+}
@@ -0,0 +1,445 @@
+// wavetables.c
+// GENERATED by tools/gen_wavetables.py - do not edit by hand
+// Q15 wavetables (-32767 to +32767), one cycle of 256 samples each
+
+#include "../include/waveform.h"
+
+const int16_t sine_table[WAVETABLE_SIZE] WAVETABLE_SECTION = {
+         0,    804,   1608,   2410,   3212,   4011,   4808,   5602,   6393,   7179,   7962,   8739,
+      9512,  10278,  11039,  11793,  12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,
+     18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,  23170,  23731,  24279,  24811,
+     25329,  25832,  26319,  26790,  27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+     30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,  32137,  32285,  32412,  32521,
+     32609,  32678,  32728,  32757,  32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,
+     32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,  30273,  29956,  29621,  29268,
+     28898,  28510,  28105,  27683,  27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+     23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,  18204,  17530,  16846,  16151,
+     15446,  14732,  14010,  13279,  12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,
+      6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,      0,   -804,  -1608,  -2410,
+     -3212,  -4011,  -4808,  -5602,  -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+    -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159,
+    -20787, -21403, -22005, -22594, -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+    -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956, -30273, -30571, -30852, -31113,
+    -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+    -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580,
+    -31356, -31113, -30852, -30571, -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+    -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731, -23170, -22594, -22005, -21403,
+    -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+    -12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,  -6393,  -5602,  -4808,  -4011,
+     -3212,  -2410,  -1608,   -804,
+};
+
+const int16_t triangle_table[WAVETABLE_SIZE] WAVETABLE_SECTION = {
+    -32767, -32255, -31743, -31231, -30719, -30207, -29695, -29183, -28671, -28159, -27647, -27135,
+    -26623, -26111, -25599, -25087, -24575, -24063, -23551, -23039, -22527, -22015, -21503, -20991,
+    -20479, -19967, -19455, -18943, -18431, -17919, -17407, -16895, -16384, -15872, -15360, -14848,
+    -14336, -13824, -13312, -12800, -12288, -11776, -11264, -10752, -10240,  -9728,  -9216,  -8704,
+     -8192,  -7680,  -7168,  -6656,  -6144,  -5632,  -5120,  -4608,  -4096,  -3584,  -3072,  -2560,
+     -2048,  -1536,  -1024,   -512,      0,    512,   1024,   1536,   2048,   2560,   3072,   3584,
+      4096,   4608,   5120,   5632,   6144,   6656,   7168,   7680,   8192,   8704,   9216,   9728,
+     10240,  10752,  11264,  11776,  12288,  12800,  13312,  13824,  14336,  14848,  15360,  15872,
+     16384,  16895,  17407,  17919,  18431,  18943,  19455,  19967,  20479,  20991,  21503,  22015,
+     22527,  23039,  23551,  24063,  24575,  25087,  25599,  26111,  26623,  27135,  27647,  28159,
+     28671,  29183,  29695,  30207,  30719,  31231,  31743,  32255,  32767,  32255,  31743,  31231,
+     30719,  30207,  29695,  29183,  28671,  28159,  27647,  27135,  26623,  26111,  25599,  25087,
+     24575,  24063,  23551,  23039,  22527,  22015,  21503,  20991,  20479,  19967,  19455,  18943,
+     18431,  17919,  17407,  16895,  16384,  15872,  15360,  14848,  14336,  13824,  13312,  12800,
+     12288,  11776,  11264,  10752,  10240,   9728,   9216,   8704,   8192,   7680,   7168,   6656,
+      6144,   5632,   5120,   4608,   4096,   3584,   3072,   2560,   2048,   1536,   1024,    512,
+         0,   -512,  -1024,  -1536,  -2048,  -2560,  -3072,  -3584,  -4096,  -4608,  -5120,  -5632,
+     -6144,  -6656,  -7168,  -7680,  -8192,  -8704,  -9216,  -9728, -10240, -10752, -11264, -11776,
+    -12288, -12800, -13312, -13824, -14336, -14848, -15360, -15872, -16384, -16895, -17407, -17919,
+    -18431, -18943, -19455, -19967, -20479, -20991, -21503, -22015, -22527, -23039, -23551, -24063,
+    -24575, -25087, -25599, -26111, -26623, -27135, -27647, -28159, -28671, -29183, -29695, -30207,
+    -30719, -31231, -31743, -32255,
+};
+
+const int16_t square_table[MIPMAP_LEVELS][WAVETABLE_SIZE] WAVETABLE_SECTION = {
+    { // level 0: harmonics 1..128
+             0,  30341,  23234,  27439,  24445,  26773,  24868,  26481,  25081,  26317,  25210,  26214,
+         25295,  26142,  25356,  26091,  25401,  26051,  25436,  26019,  25463,  25995,  25487,  25974,
+         25504,  25958,  25520,  25943,  25533,  25931,  25545,  25920,  25554,  25912,  25563,  25904,
+         25569,  25898,  25576,  25892,  25582,  25886,  25586,  25882,  25590,  25878,  25594,  25875,
+         25597,  25872,  25599,  25870,  25601,  25868,  25603,  25866,  25604,  25865,  25605,  25865,
+         25606,  25863,  25608,  25863,  25607,  25863,  25608,  25863,  25606,  25865,  25605,  25865,
+         25604,  25866,  25603,  25868,  25601,  25870,  25599,  25872,  25597,  25875,  25594,  25878,
+         25590,  25882,  25586,  25886,  25582,  25892,  25576,  25898,  25569,  25904,  25563,  25912,
+         25554,  25920,  25545,  25931,  25533,  25943,  25520,  25958,  25504,  25974,  25487,  25995,
+         25463,  26019,  25436,  26051,  25401,  26091,  25356,  26142,  25295,  26214,  25210,  26317,
+         25081,  26481,  24868,  26773,  24445,  27439,  23234,  30341,      0, -30341, -23234, -27439,
+        -24445, -26773, -24868, -26481, -25081, -26317, -25210, -26214, -25295, -26142, -25356, -26091,
+        -25401, -26051, -25436, -26019, -25463, -25995, -25487, -25974, -25504, -25958, -25520, -25943,
+        -25533, -25931, -25545, -25920, -25554, -25912, -25563, -25904, -25569, -25898, -25576, -25892,
+        -25582, -25886, -25586, -25882, -25590, -25878, -25594, -25875, -25597, -25872, -25599, -25870,
+        -25601, -25868, -25603, -25866, -25604, -25865, -25605, -25865, -25606, -25863, -25608, -25863,
+        -25607, -25863, -25608, -25863, -25606, -25865, -25605, -25865, -25604, -25866, -25603, -25868,
+        -25601, -25870, -25599, -25872, -25597, -25875, -25594, -25878, -25590, -25882, -25586, -25886,
+        -25582, -25892, -25576, -25898, -25569, -25904, -25563, -25912, -25554, -25920, -25545, -25931,
+        -25533, -25943, -25520, -25958, -25504, -25974, -25487, -25995, -25463, -26019, -25436, -26051,
+        -25401, -26091, -25356, -26142, -25295, -26214, -25210, -26317, -25081, -26481, -24868, -26773,
+        -24445, -27439, -23234, -30341,
+    },
+    { // level 1: harmonics 1..64
+             0,  22458,  30344,  26350,  23230,  25491,  27445,  25864,  24439,  25656,  26781,  25788,
+         24858,  25697,  26492,  25764,  25068,  25713,  26333,  25752,  25193,  25721,  26233,  25747,
+         25275,  25726,  26164,  25743,  25332,  25728,  26116,  25741,  25374,  25730,  26081,  25739,
+         25404,  25731,  26054,  25739,  25428,  25732,  26033,  25738,  25445,  25733,  26018,  25737,
+         25459,  25733,  26007,  25736,  25468,  25734,  25999,  25736,  25474,  25735,  25994,  25736,
+         25478,  25735,  25992,  25735,  25479,  25735,  25992,  25735,  25478,  25736,  25994,  25735,
+         25474,  25736,  25999,  25734,  25468,  25736,  26007,  25733,  25459,  25737,  26018,  25733,
+         25445,  25738,  26033,  25732,  25428,  25739,  26054,  25731,  25404,  25739,  26081,  25730,
+         25374,  25741,  26116,  25728,  25332,  25743,  26164,  25726,  25275,  25747,  26233,  25721,
+         25193,  25752,  26333,  25713,  25068,  25764,  26492,  25697,  24858,  25788,  26781,  25656,
+         24439,  25864,  27445,  25491,  23230,  26350,  30344,  22458,      0, -22458, -30344, -26350,
+        -23230, -25491, -27445, -25864, -24439, -25656, -26781, -25788, -24858, -25697, -26492, -25764,
+        -25068, -25713, -26333, -25752, -25193, -25721, -26233, -25747, -25275, -25726, -26164, -25743,
+        -25332, -25728, -26116, -25741, -25374, -25730, -26081, -25739, -25404, -25731, -26054, -25739,
+        -25428, -25732, -26033, -25738, -25445, -25733, -26018, -25737, -25459, -25733, -26007, -25736,
+        -25468, -25734, -25999, -25736, -25474, -25735, -25994, -25736, -25478, -25735, -25992, -25735,
+        -25479, -25735, -25992, -25735, -25478, -25736, -25994, -25735, -25474, -25736, -25999, -25734,
+        -25468, -25736, -26007, -25733, -25459, -25737, -26018, -25733, -25445, -25738, -26033, -25732,
+        -25428, -25739, -26054, -25731, -25404, -25739, -26081, -25730, -25374, -25741, -26116, -25728,
+        -25332, -25743, -26164, -25726, -25275, -25747, -26233, -25721, -25193, -25752, -26333, -25713,
+        -25068, -25764, -26492, -25697, -24858, -25788, -26781, -25656, -24439, -25864, -27445, -25491,
+        -23230, -26350, -30344, -22458,
+    },
+    { // level 2: harmonics 1..32
+             0,  12435,  22461,  28509,  30350,  29032,  26348,  24055,  23218,  23928,  25493,  26917,
+         27464,  26973,  25862,  24821,  24412,  24790,  25659,  26485,  26813,  26504,  25787,  25095,
+         24818,  25082,  25699,  26298,  26539,  26308,  25761,  25229,  25013,  25222,  25716,  26199,
+         26396,  26205,  25750,  25303,  25121,  25299,  25724,  26143,  26315,  26146,  25743,  25345,
+         25182,  25343,  25729,  26112,  26270,  26114,  25739,  25367,  25213,  25367,  25732,  26099,
+         26249,  26098,  25736,  25374,  25224,  25374,  25736,  26098,  26249,  26099,  25732,  25367,
+         25213,  25367,  25739,  26114,  26270,  26112,  25729,  25343,  25182,  25345,  25743,  26146,
+         26315,  26143,  25724,  25299,  25121,  25303,  25750,  26205,  26396,  26199,  25716,  25222,
+         25013,  25229,  25761,  26308,  26539,  26298,  25699,  25082,  24818,  25095,  25787,  26504,
+         26813,  26485,  25659,  24790,  24412,  24821,  25862,  26973,  27464,  26917,  25493,  23928,
+         23218,  24055,  26348,  29032,  30350,  28509,  22461,  12435,      0, -12435, -22461, -28509,
+        -30350, -29032, -26348, -24055, -23218, -23928, -25493, -26917, -27464, -26973, -25862, -24821,
+        -24412, -24790, -25659, -26485, -26813, -26504, -25787, -25095, -24818, -25082, -25699, -26298,
+        -26539, -26308, -25761, -25229, -25013, -25222, -25716, -26199, -26396, -26205, -25750, -25303,
+        -25121, -25299, -25724, -26143, -26315, -26146, -25743, -25345, -25182, -25343, -25729, -26112,
+        -26270, -26114, -25739, -25367, -25213, -25367, -25732, -26099, -26249, -26098, -25736, -25374,
+        -25224, -25374, -25736, -26098, -26249, -26099, -25732, -25367, -25213, -25367, -25739, -26114,
+        -26270, -26112, -25729, -25343, -25182, -25345, -25743, -26146, -26315, -26143, -25724, -25299,
+        -25121, -25303, -25750, -26205, -26396, -26199, -25716, -25222, -25013, -25229, -25761, -26308,
+        -26539, -26298, -25699, -25082, -24818, -25095, -25787, -26504, -26813, -26485, -25659, -24790,
+        -24412, -24821, -25862, -26973, -27464, -26917, -25493, -23928, -23218, -24055, -26348, -29032,
+        -30350, -28509, -22461, -12435,
+    },
+    { // level 3: harmonics 1..16
+             0,   6379,  12437,  17878,  22469,  26044,  28529,  29939,  30375,  30005,  29049,  27746,
+         26340,  25041,  24018,  23379,  23166,  23363,  23894,  24650,  25501,  26315,  26976,  27399,
+         27542,  27406,  27027,  26479,  25852,  25244,  24742,  24415,  24303,  24411,  24714,  25157,
+         25669,  26172,  26589,  26863,  26958,  26865,  26605,  26220,  25773,  25331,  24962,  24718,
+         24633,  24716,  24953,  25304,  25715,  26123,  26467,  26695,  26774,  26696,  26471,  26136,
+         25741,  25348,  25016,  24793,  24715,  24793,  25016,  25348,  25741,  26136,  26471,  26696,
+         26774,  26695,  26467,  26123,  25715,  25304,  24953,  24716,  24633,  24718,  24962,  25331,
+         25773,  26220,  26605,  26865,  26958,  26863,  26589,  26172,  25669,  25157,  24714,  24411,
+         24303,  24415,  24742,  25244,  25852,  26479,  27027,  27406,  27542,  27399,  26976,  26315,
+         25501,  24650,  23894,  23363,  23166,  23379,  24018,  25041,  26340,  27746,  29049,  30005,
+         30375,  29939,  28529,  26044,  22469,  17878,  12437,   6379,      0,  -6379, -12437, -17878,
+        -22469, -26044, -28529, -29939, -30375, -30005, -29049, -27746, -26340, -25041, -24018, -23379,
+        -23166, -23363, -23894, -24650, -25501, -26315, -26976, -27399, -27542, -27406, -27027, -26479,
+        -25852, -25244, -24742, -24415, -24303, -24411, -24714, -25157, -25669, -26172, -26589, -26863,
+        -26958, -26865, -26605, -26220, -25773, -25331, -24962, -24718, -24633, -24716, -24953, -25304,
+        -25715, -26123, -26467, -26695, -26774, -26696, -26471, -26136, -25741, -25348, -25016, -24793,
+        -24715, -24793, -25016, -25348, -25741, -26136, -26471, -26696, -26774, -26695, -26467, -26123,
+        -25715, -25304, -24953, -24716, -24633, -24718, -24962, -25331, -25773, -26220, -26605, -26865,
+        -26958, -26863, -26589, -26172, -25669, -25157, -24714, -24411, -24303, -24415, -24742, -25244,
+        -25852, -26479, -27027, -27406, -27542, -27399, -26976, -26315, -25501, -24650, -23894, -23363,
+        -23166, -23379, -24018, -25041, -26340, -27746, -29049, -30005, -30375, -29939, -28529, -26044,
+        -22469, -17878, -12437,  -6379,
+    },
+    { // level 4: harmonics 1..8
+             0,   3210,   6380,   9469,  12441,  15260,  17894,  20315,  22501,  24432,  26098,  27488,
+         28605,  29450,  30033,  30369,  30476,  30378,  30099,  29667,  29114,  28471,  27769,  27036,
+         26303,  25597,  24941,  24356,  23859,  23463,  23177,  23005,  22949,  23004,  23163,  23415,
+         23748,  24146,  24590,  25064,  25549,  26025,  26477,  26887,  27241,  27528,  27739,  27867,
+         27910,  27867,  27743,  27543,  27276,  26953,  26587,  26192,  25783,  25378,  24988,  24631,
+         24318,  24062,  23874,  23756,  23717,  23756,  23874,  24062,  24318,  24631,  24988,  25378,
+         25783,  26192,  26587,  26953,  27276,  27543,  27743,  27867,  27910,  27867,  27739,  27528,
+         27241,  26887,  26477,  26025,  25549,  25064,  24590,  24146,  23748,  23415,  23163,  23004,
+         22949,  23005,  23177,  23463,  23859,  24356,  24941,  25597,  26303,  27036,  27769,  28471,
+         29114,  29667,  30099,  30378,  30476,  30369,  30033,  29450,  28605,  27488,  26098,  24432,
+         22501,  20315,  17894,  15260,  12441,   9469,   6380,   3210,      0,  -3210,  -6380,  -9469,
+        -12441, -15260, -17894, -20315, -22501, -24432, -26098, -27488, -28605, -29450, -30033, -30369,
+        -30476, -30378, -30099, -29667, -29114, -28471, -27769, -27036, -26303, -25597, -24941, -24356,
+        -23859, -23463, -23177, -23005, -22949, -23004, -23163, -23415, -23748, -24146, -24590, -25064,
+        -25549, -26025, -26477, -26887, -27241, -27528, -27739, -27867, -27910, -27867, -27743, -27543,
+        -27276, -26953, -26587, -26192, -25783, -25378, -24988, -24631, -24318, -24062, -23874, -23756,
+        -23717, -23756, -23874, -24062, -24318, -24631, -24988, -25378, -25783, -26192, -26587, -26953,
+        -27276, -27543, -27743, -27867, -27910, -27867, -27739, -27528, -27241, -26887, -26477, -26025,
+        -25549, -25064, -24590, -24146, -23748, -23415, -23163, -23004, -22949, -23005, -23177, -23463,
+        -23859, -24356, -24941, -25597, -26303, -27036, -27769, -28471, -29114, -29667, -30099, -30378,
+        -30476, -30369, -30033, -29450, -28605, -27488, -26098, -24432, -22501, -20315, -17894, -15260,
+        -12441,  -9469,  -6380,  -3210,
+    },
+    { // level 5: harmonics 1..4
+             0,   1607,   3211,   4803,   6383,   7942,   9478,  10986,  12461,  13899,  15297,  16649,
+         17955,  19208,  20407,  21549,  22630,  23650,  24605,  25494,  26316,  27070,  27755,  28370,
+         28916,  29395,  29803,  30144,  30420,  30631,  30778,  30864,  30893,  30865,  30785,  30654,
+         30478,  30258,  29999,  29703,  29376,  29020,  28641,  28242,  27827,  27401,  26967,  26530,
+         26093,  25660,  25237,  24824,  24427,  24049,  23692,  23360,  23055,  22782,  22538,  22331,
+         22157,  22021,  21924,  21864,  21845,  21864,  21924,  22021,  22157,  22331,  22538,  22782,
+         23055,  23360,  23692,  24049,  24427,  24824,  25237,  25660,  26093,  26530,  26967,  27401,
+         27827,  28242,  28641,  29020,  29376,  29703,  29999,  30258,  30478,  30654,  30785,  30865,
+         30893,  30864,  30778,  30631,  30420,  30144,  29803,  29395,  28916,  28370,  27755,  27070,
+         26316,  25494,  24605,  23650,  22630,  21549,  20407,  19208,  17955,  16649,  15297,  13899,
+         12461,  10986,   9478,   7942,   6383,   4803,   3211,   1607,      0,  -1607,  -3211,  -4803,
+         -6383,  -7942,  -9478, -10986, -12461, -13899, -15297, -16649, -17955, -19208, -20407, -21549,
+        -22630, -23650, -24605, -25494, -26316, -27070, -27755, -28370, -28916, -29395, -29803, -30144,
+        -30420, -30631, -30778, -30864, -30893, -30865, -30785, -30654, -30478, -30258, -29999, -29703,
+        -29376, -29020, -28641, -28242, -27827, -27401, -26967, -26530, -26093, -25660, -25237, -24824,
+        -24427, -24049, -23692, -23360, -23055, -22782, -22538, -22331, -22157, -22021, -21924, -21864,
+        -21845, -21864, -21924, -22021, -22157, -22331, -22538, -22782, -23055, -23360, -23692, -24049,
+        -24427, -24824, -25237, -25660, -26093, -26530, -26967, -27401, -27827, -28242, -28641, -29020,
+        -29376, -29703, -29999, -30258, -30478, -30654, -30785, -30865, -30893, -30864, -30778, -30631,
+        -30420, -30144, -29803, -29395, -28916, -28370, -27755, -27070, -26316, -25494, -24605, -23650,
+        -22630, -21549, -20407, -19208, -17955, -16649, -15297, -13899, -12461, -10986,  -9478,  -7942,
+         -6383,  -4803,  -3211,  -1607,
+    },
+    { // level 6: harmonics 1..2
+             0,    804,   1608,   2410,   3212,   4011,   4808,   5602,   6393,   7179,   7962,   8739,
+          9512,  10278,  11039,  11793,  12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,
+         18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,  23170,  23731,  24279,  24811,
+         25329,  25832,  26319,  26790,  27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+         30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,  32137,  32285,  32412,  32521,
+         32609,  32678,  32728,  32757,  32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,
+         32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,  30273,  29956,  29621,  29268,
+         28898,  28510,  28105,  27683,  27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+         23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,  18204,  17530,  16846,  16151,
+         15446,  14732,  14010,  13279,  12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,
+          6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,      0,   -804,  -1608,  -2410,
+         -3212,  -4011,  -4808,  -5602,  -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+        -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159,
+        -20787, -21403, -22005, -22594, -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+        -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956, -30273, -30571, -30852, -31113,
+        -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+        -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580,
+        -31356, -31113, -30852, -30571, -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+        -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731, -23170, -22594, -22005, -21403,
+        -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+        -12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,  -6393,  -5602,  -4808,  -4011,
+         -3212,  -2410,  -1608,   -804,
+    },
+    { // level 7: harmonics 1..1
+             0,    804,   1608,   2410,   3212,   4011,   4808,   5602,   6393,   7179,   7962,   8739,
+          9512,  10278,  11039,  11793,  12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,
+         18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,  23170,  23731,  24279,  24811,
+         25329,  25832,  26319,  26790,  27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+         30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,  32137,  32285,  32412,  32521,
+         32609,  32678,  32728,  32757,  32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,
+         32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,  30273,  29956,  29621,  29268,
+         28898,  28510,  28105,  27683,  27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+         23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,  18204,  17530,  16846,  16151,
+         15446,  14732,  14010,  13279,  12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,
+          6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,      0,   -804,  -1608,  -2410,
+         -3212,  -4011,  -4808,  -5602,  -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+        -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159,
+        -20787, -21403, -22005, -22594, -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+        -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956, -30273, -30571, -30852, -31113,
+        -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+        -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580,
+        -31356, -31113, -30852, -30571, -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+        -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731, -23170, -22594, -22005, -21403,
+        -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+        -12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,  -6393,  -5602,  -4808,  -4011,
+         -3212,  -2410,  -1608,   -804,
+    },
+};
+
+const int16_t sawtooth_table[MIPMAP_LEVELS][WAVETABLE_SIZE] WAVETABLE_SECTION = {
+    { // level 0: harmonics 1..128
+             0, -32767, -24823, -29173, -25705, -28009, -25729, -27253, -25526, -26637, -25230, -26085,
+        -24887, -25568, -24518, -25073, -24131, -24591, -23734, -24118, -23329, -23652, -22919, -23191,
+        -22503, -22734, -22084, -22279, -21663, -21827, -21241, -21376, -20816, -20927, -20390, -20480,
+        -19962, -20034, -19534, -19588, -19105, -19143, -18675, -18699, -18245, -18255, -17814, -17812,
+        -17383, -17369, -16951, -16927, -16518, -16485, -16086, -16044, -15653, -15602, -15220, -15161,
+        -14787, -14720, -14354, -14279, -13920, -13838, -13486, -13398, -13052, -12958, -12617, -12518,
+        -12183, -12077, -11749, -11638, -11315, -11198, -10880, -10758, -10446, -10319, -10011,  -9879,
+         -9576,  -9440,  -9141,  -9000,  -8706,  -8561,  -8271,  -8122,  -7836,  -7682,  -7401,  -7243,
+         -6966,  -6804,  -6531,  -6365,  -6095,  -5926,  -5660,  -5487,  -5224,  -5048,  -4790,  -4609,
+         -4354,  -4169,  -3919,  -3731,  -3483,  -3292,  -3048,  -2853,  -2613,  -2413,  -2177,  -1975,
+         -1742,  -1536,  -1306,  -1097,   -871,   -658,   -436,   -219,      0,    219,    436,    658,
+           871,   1097,   1306,   1536,   1742,   1975,   2177,   2413,   2613,   2853,   3048,   3292,
+          3483,   3731,   3919,   4169,   4354,   4609,   4790,   5048,   5224,   5487,   5660,   5926,
+          6095,   6365,   6531,   6804,   6966,   7243,   7401,   7682,   7836,   8122,   8271,   8561,
+          8706,   9000,   9141,   9440,   9576,   9879,  10011,  10319,  10446,  10758,  10880,  11198,
+         11315,  11638,  11749,  12077,  12183,  12518,  12617,  12958,  13052,  13398,  13486,  13838,
+         13920,  14279,  14354,  14720,  14787,  15161,  15220,  15602,  15653,  16044,  16086,  16485,
+         16518,  16927,  16951,  17369,  17383,  17812,  17814,  18255,  18245,  18699,  18675,  19143,
+         19105,  19588,  19534,  20034,  19962,  20480,  20390,  20927,  20816,  21376,  21241,  21827,
+         21663,  22279,  22084,  22734,  22503,  23191,  22919,  23652,  23329,  24118,  23734,  24591,
+         24131,  25073,  24518,  25568,  24887,  26085,  25230,  26637,  25526,  27253,  25729,  28009,
+         25705,  29173,  24823,  32767,
+    },
+    { // level 1: harmonics 1..64
+             0, -24336, -32548, -27853, -24388, -26758, -28515, -26450, -24834, -26063, -26912, -25494,
+        -24422, -25233, -25717, -24593, -23784, -24377, -24662, -23706, -23052, -23511, -23672, -22826,
+        -22274, -22641, -22716, -21948, -21469, -21770, -21781, -21071, -20648, -20897, -20860, -20195,
+        -19815, -20025, -19949, -19320, -18975, -19151, -19043, -18445, -18129, -18277, -18143, -17570,
+        -17279, -17403, -17247, -16695, -16424, -16530, -16353, -15820, -15568, -15656, -15462, -14946,
+        -14710, -14782, -14573, -14071, -13850, -13908, -13685, -13196, -12989, -13034, -12797, -12322,
+        -12126, -12159, -11912, -11447, -11263, -11285, -11027, -10573, -10399, -10411, -10143,  -9698,
+         -9534,  -9537,  -9259,  -8824,  -8669,  -8663,  -8376,  -7950,  -7803,  -7788,  -7494,  -7075,
+         -6937,  -6914,  -6611,  -6201,  -6071,  -6040,  -5729,  -5327,  -5203,  -5165,  -4848,  -4452,
+         -4336,  -4291,  -3966,  -3578,  -3469,  -3417,  -3085,  -2703,  -2602,  -2542,  -2203,  -1829,
+         -1735,  -1668,  -1322,   -955,   -868,   -793,   -441,    -80,      0,     80,    441,    793,
+           868,    955,   1322,   1668,   1735,   1829,   2203,   2542,   2602,   2703,   3085,   3417,
+          3469,   3578,   3966,   4291,   4336,   4452,   4848,   5165,   5203,   5327,   5729,   6040,
+          6071,   6201,   6611,   6914,   6937,   7075,   7494,   7788,   7803,   7950,   8376,   8663,
+          8669,   8824,   9259,   9537,   9534,   9698,  10143,  10411,  10399,  10573,  11027,  11285,
+         11263,  11447,  11912,  12159,  12126,  12322,  12797,  13034,  12989,  13196,  13685,  13908,
+         13850,  14071,  14573,  14782,  14710,  14946,  15462,  15656,  15568,  15820,  16353,  16530,
+         16424,  16695,  17247,  17403,  17279,  17570,  18143,  18277,  18129,  18445,  19043,  19151,
+         18975,  19320,  19949,  20025,  19815,  20195,  20860,  20897,  20648,  21071,  21781,  21770,
+         21469,  21948,  22716,  22641,  22274,  22826,  23672,  23511,  23052,  23706,  24662,  24377,
+         23784,  24593,  25717,  25233,  24422,  25494,  26912,  26063,  24834,  26450,  28515,  26758,
+         24388,  27853,  32548,  24336,
+    },
+    { // level 2: harmonics 1..32
+             0, -13497, -24255, -30525, -32107, -30264, -27059, -24445, -23520, -24263, -25803, -27027,
+        -27193, -26257, -24782, -23549, -23099, -23470, -24234, -24787, -24709, -23979, -22952, -22119,
+        -21820, -22060, -22530, -22814, -22632, -21995, -21176, -20537, -20314, -20485, -20799, -20935,
+        -20696, -20112, -19416, -18893, -18716, -18843, -19058, -19101, -18824, -18275, -17660, -17217,
+        -17071, -17169, -17315, -17290, -16987, -16464, -15908, -15522, -15399, -15475, -15569, -15495,
+        -15170, -14666, -14157, -13816, -13711, -13770, -13822, -13707, -13367, -12879, -12407, -12102,
+        -12012, -12056, -12075, -11926, -11573, -11097, -10657, -10383, -10306, -10338, -10327, -10150,
+         -9784,  -9321,  -8908,  -8661,  -8595,  -8616,  -8579,  -8377,  -8000,  -7547,  -7159,  -6935,
+         -6880,  -6890,  -6831,  -6606,  -6220,  -5776,  -5410,  -5209,  -5161,  -5164,  -5083,  -4836,
+         -4441,  -4006,  -3661,  -3481,  -3442,  -3436,  -3334,  -3067,  -2664,  -2237,  -1912,  -1751,
+         -1721,  -1707,  -1586,  -1299,   -888,   -469,   -163,    -22,      0,     22,    163,    469,
+           888,   1299,   1586,   1707,   1721,   1751,   1912,   2237,   2664,   3067,   3334,   3436,
+          3442,   3481,   3661,   4006,   4441,   4836,   5083,   5164,   5161,   5209,   5410,   5776,
+          6220,   6606,   6831,   6890,   6880,   6935,   7159,   7547,   8000,   8377,   8579,   8616,
+          8595,   8661,   8908,   9321,   9784,  10150,  10327,  10338,  10306,  10383,  10657,  11097,
+         11573,  11926,  12075,  12056,  12012,  12102,  12407,  12879,  13367,  13707,  13822,  13770,
+         13711,  13816,  14157,  14666,  15170,  15495,  15569,  15475,  15399,  15522,  15908,  16464,
+         16987,  17290,  17315,  17169,  17071,  17217,  17660,  18275,  18824,  19101,  19058,  18843,
+         18716,  18893,  19416,  20112,  20696,  20935,  20799,  20485,  20314,  20537,  21176,  21995,
+         22632,  22814,  22530,  22060,  21820,  22119,  22952,  23979,  24709,  24787,  24234,  23470,
+         23099,  23549,  24782,  26257,  27193,  27027,  25803,  24263,  23520,  24445,  27059,  30264,
+         32107,  30525,  24255,  13497,
+    },
+    { // level 3: harmonics 1..16
+             0,  -6929, -13474, -19287, -24092, -27706, -30056, -31181, -31219, -30390, -28965, -27234,
+        -25474, -23918, -22738, -22027, -21799, -21998, -22511, -23194, -23891, -24459, -24790, -24817,
+        -24529, -23962, -23190, -22316, -21448, -20688, -20113, -19767, -19657, -19751, -19990, -20292,
+        -20573, -20756, -20781, -20619, -20268, -19758, -19143, -18490, -17869, -17342, -16955, -16729,
+        -16659, -16715, -16851, -17005, -17120, -17143, -17038, -16792, -16412, -15931, -15390, -14844,
+        -14345, -13937, -13647, -13483, -13435, -13471, -13549, -13621, -13640, -13570, -13388, -13092,
+        -12696, -12230, -11736, -11257, -10837, -10504, -10277, -10155, -10121, -10143, -10183, -10197,
+        -10151, -10016,  -9780,  -9448,  -9040,  -8586,  -8126,  -7697,  -7333,  -7058,  -6879,  -6788,
+         -6765,  -6776,  -6785,  -6756,  -6657,  -6471,  -6193,  -5833,  -5414,  -4970,  -4537,  -4149,
+         -3833,  -3605,  -3466,  -3401,  -3387,  -3389,  -3373,  -3305,  -3162,  -2931,  -2616,  -2230,
+         -1804,  -1368,   -959,   -608,   -335,   -149,    -46,     -6,      0,      6,     46,    149,
+           335,    608,    959,   1368,   1804,   2230,   2616,   2931,   3162,   3305,   3373,   3389,
+          3387,   3401,   3466,   3605,   3833,   4149,   4537,   4970,   5414,   5833,   6193,   6471,
+          6657,   6756,   6785,   6776,   6765,   6788,   6879,   7058,   7333,   7697,   8126,   8586,
+          9040,   9448,   9780,  10016,  10151,  10197,  10183,  10143,  10121,  10155,  10277,  10504,
+         10837,  11257,  11736,  12230,  12696,  13092,  13388,  13570,  13640,  13621,  13549,  13471,
+         13435,  13483,  13647,  13937,  14345,  14844,  15390,  15931,  16412,  16792,  17038,  17143,
+         17120,  17005,  16851,  16715,  16659,  16729,  16955,  17342,  17869,  18490,  19143,  19758,
+         20268,  20619,  20781,  20756,  20573,  20292,  19990,  19751,  19657,  19767,  20113,  20688,
+         21448,  22316,  23190,  23962,  24529,  24817,  24790,  24459,  23891,  23194,  22511,  21998,
+         21799,  22027,  22738,  23918,  25474,  27234,  28965,  30390,  31219,  31181,  30056,  27706,
+         24092,  19287,  13474,   6929,
+    },
+    { // level 4: harmonics 1..8
+             0,  -3488,  -6924, -10253, -13428, -16403, -19138, -21598, -23757, -25594, -27098, -28264,
+        -29097, -29607, -29813, -29739, -29416, -28877, -28160, -27304, -26350, -25337, -24303, -23284,
+        -22312, -21415, -20613, -19926, -19365, -18936, -18638, -18466, -18412, -18461, -18596, -18798,
+        -19045, -19317, -19589, -19842, -20058, -20218, -20310, -20324, -20252, -20093, -19847, -19518,
+        -19115, -18648, -18129, -17574, -16998, -16416, -15845, -15299, -14791, -14333, -13932, -13596,
+        -13327, -13126, -12991, -12915, -12892, -12912, -12963, -13033, -13110, -13182, -13234, -13257,
+        -13240, -13176, -13059, -12886, -12656, -12370, -12032, -11649, -11228, -10778, -10310,  -9834,
+         -9363,  -8907,  -8475,  -8076,  -7718,  -7407,  -7145,  -6934,  -6772,  -6658,  -6586,  -6548,
+         -6538,  -6544,  -6560,  -6573,  -6573,  -6552,  -6501,  -6414,  -6284,  -6108,  -5886,  -5616,
+         -5302,  -4949,  -4562,  -4149,  -3717,  -3277,  -2839,  -2410,  -2002,  -1620,  -1274,   -968,
+          -705,   -488,   -316,   -187,    -98,    -42,    -13,     -1,      0,      1,     13,     42,
+            98,    187,    316,    488,    705,    968,   1274,   1620,   2002,   2410,   2839,   3277,
+          3717,   4149,   4562,   4949,   5302,   5616,   5886,   6108,   6284,   6414,   6501,   6552,
+          6573,   6573,   6560,   6544,   6538,   6548,   6586,   6658,   6772,   6934,   7145,   7407,
+          7718,   8076,   8475,   8907,   9363,   9834,  10310,  10778,  11228,  11649,  12032,  12370,
+         12656,  12886,  13059,  13176,  13240,  13257,  13234,  13182,  13110,  13033,  12963,  12912,
+         12892,  12915,  12991,  13126,  13327,  13596,  13932,  14333,  14791,  15299,  15845,  16416,
+         16998,  17574,  18129,  18648,  19115,  19518,  19847,  20093,  20252,  20324,  20310,  20218,
+         20058,  19842,  19589,  19317,  19045,  18798,  18596,  18461,  18412,  18466,  18638,  18936,
+         19365,  19926,  20613,  21415,  22312,  23284,  24303,  25337,  26350,  27304,  28160,  28877,
+         29416,  29739,  29813,  29607,  29097,  28264,  27098,  25594,  23757,  21598,  19138,  16403,
+         13428,  10253,   6924,   3488,
+    },
+    { // level 5: harmonics 1..4
+             0,  -1747,  -3487,  -5210,  -6911,  -8580, -10211, -11797, -13330, -14805, -16216, -17556,
+        -18822, -20007, -21110, -22126, -23052, -23886, -24626, -25272, -25824, -26281, -26644, -26914,
+        -27095, -27189, -27197, -27124, -26974, -26752, -26462, -26109, -25699, -25237, -24728, -24180,
+        -23598, -22988, -22355, -21706, -21048, -20383, -19721, -19063, -18417, -17787, -17176, -16589,
+        -16028, -15498, -15001, -14538, -14112, -13724, -13374, -13064, -12792, -12559, -12363, -12204,
+        -12078, -11984, -11922, -11886, -11874, -11885, -11913, -11956, -12011, -12074, -12140, -12208,
+        -12273, -12333, -12383, -12421, -12444, -12450, -12436, -12399, -12339, -12254, -12142, -12002,
+        -11835, -11640, -11417, -11166, -10889, -10586, -10258,  -9908,  -9537,  -9147,  -8740,  -8319,
+         -7887,  -7446,  -6999,  -6548,  -6097,  -5648,  -5204,  -4768,  -4342,  -3929,  -3531,  -3149,
+         -2786,  -2443,  -2123,  -1825,  -1551,  -1301,  -1076,   -875,   -698,   -545,   -415,   -305,
+          -217,   -146,    -93,    -54,    -28,    -11,     -3,      0,      0,      0,      3,     11,
+            28,     54,     93,    146,    217,    305,    415,    545,    698,    875,   1076,   1301,
+          1551,   1825,   2123,   2443,   2786,   3149,   3531,   3929,   4342,   4768,   5204,   5648,
+          6097,   6548,   6999,   7446,   7887,   8319,   8740,   9147,   9537,   9908,  10258,  10586,
+         10889,  11166,  11417,  11640,  11835,  12002,  12142,  12254,  12339,  12399,  12436,  12450,
+         12444,  12421,  12383,  12333,  12273,  12208,  12140,  12074,  12011,  11956,  11913,  11885,
+         11874,  11886,  11922,  11984,  12078,  12204,  12363,  12559,  12792,  13064,  13374,  13724,
+         14112,  14538,  15001,  15498,  16028,  16589,  17176,  17787,  18417,  19063,  19721,  20383,
+         21048,  21706,  22355,  22988,  23598,  24180,  24728,  25237,  25699,  26109,  26462,  26752,
+         26974,  27124,  27197,  27189,  27095,  26914,  26644,  26281,  25824,  25272,  24626,  23886,
+         23052,  22126,  21110,  20007,  18822,  17556,  16216,  14805,  13330,  11797,  10211,   8580,
+          6911,   5210,   3487,   1747,
+    },
+    { // level 6: harmonics 1..2
+             0,   -874,  -1747,  -2617,  -3484,  -4344,  -5199,  -6045,  -6883,  -7710,  -8526,  -9329,
+        -10118, -10892, -11650, -12391, -13113, -13817, -14500, -15161, -15801, -16418, -17011, -17580,
+        -18123, -18642, -19132, -19597, -20034, -20444, -20824, -21177, -21501, -21795, -22060, -22296,
+        -22503, -22681, -22829, -22948, -23038, -23099, -23132, -23136, -23113, -23063, -22986, -22882,
+        -22753, -22599, -22420, -22218, -21992, -21745, -21476, -21187, -20877, -20550, -20204, -19842,
+        -19463, -19070, -18663, -18243, -17812, -17369, -16917, -16456, -15988, -15514, -15033, -14549,
+        -14061, -13571, -13080, -12588, -12097, -11607, -11121, -10637, -10158,  -9685,  -9217,  -8756,
+         -8303,  -7859,  -7423,  -6997,  -6582,  -6177,  -5784,  -5403,  -5034,  -4678,  -4335,  -4005,
+         -3689,  -3387,  -3099,  -2825,  -2565,  -2319,  -2088,  -1871,  -1667,  -1478,  -1303,  -1141,
+          -991,   -855,   -731,   -619,   -519,   -430,   -351,   -282,   -223,   -172,   -130,    -95,
+           -67,    -45,    -28,    -16,     -8,     -3,     -1,      0,      0,      0,      1,      3,
+             8,     16,     28,     45,     67,     95,    130,    172,    223,    282,    351,    430,
+           519,    619,    731,    855,    991,   1141,   1303,   1478,   1667,   1871,   2088,   2319,
+          2565,   2825,   3099,   3387,   3689,   4005,   4335,   4678,   5034,   5403,   5784,   6177,
+          6582,   6997,   7423,   7859,   8303,   8756,   9217,   9685,  10158,  10637,  11121,  11607,
+         12097,  12588,  13080,  13571,  14061,  14549,  15033,  15514,  15988,  16456,  16917,  17369,
+         17812,  18243,  18663,  19070,  19463,  19842,  20204,  20550,  20877,  21187,  21476,  21745,
+         21992,  22218,  22420,  22599,  22753,  22882,  22986,  23063,  23113,  23136,  23132,  23099,
+         23038,  22948,  22829,  22681,  22503,  22296,  22060,  21795,  21501,  21177,  20824,  20444,
+         20034,  19597,  19132,  18642,  18123,  17580,  17011,  16418,  15801,  15161,  14500,  13817,
+         13113,  12391,  11650,  10892,  10118,   9329,   8526,   7710,   6883,   6045,   5199,   4344,
+          3484,   2617,   1747,    874,
+    },
+    { // level 7: harmonics 1..1
+             0,   -437,   -874,  -1310,  -1746,  -2180,  -2614,  -3045,  -3475,  -3902,  -4328,  -4750,
+         -5171,  -5587,  -6001,  -6410,  -6816,  -7218,  -7616,  -8008,  -8396,  -8779,  -9157,  -9529,
+         -9895, -10256, -10610, -10958, -11299, -11634, -11962, -12282, -12595, -12900, -13198, -13487,
+        -13768, -14042, -14307, -14563, -14810, -15048, -15277, -15498, -15708, -15910, -16101, -16284,
+        -16456, -16618, -16771, -16912, -17045, -17166, -17278, -17379, -17469, -17550, -17619, -17678,
+        -17726, -17763, -17790, -17806, -17812, -17806, -17790, -17763, -17726, -17678, -17619, -17550,
+        -17469, -17379, -17278, -17166, -17045, -16912, -16771, -16618, -16456, -16284, -16101, -15910,
+        -15708, -15498, -15277, -15048, -14810, -14563, -14307, -14042, -13768, -13487, -13198, -12900,
+        -12595, -12282, -11962, -11634, -11299, -10958, -10610, -10256,  -9895,  -9529,  -9157,  -8779,
+         -8396,  -8008,  -7616,  -7218,  -6816,  -6410,  -6001,  -5587,  -5171,  -4750,  -4328,  -3902,
+         -3475,  -3045,  -2614,  -2180,  -1746,  -1310,   -874,   -437,      0,    437,    874,   1310,
+          1746,   2180,   2614,   3045,   3475,   3902,   4328,   4750,   5171,   5587,   6001,   6410,
+          6816,   7218,   7616,   8008,   8396,   8779,   9157,   9529,   9895,  10256,  10610,  10958,
+         11299,  11634,  11962,  12282,  12595,  12900,  13198,  13487,  13768,  14042,  14307,  14563,
+         14810,  15048,  15277,  15498,  15708,  15910,  16101,  16284,  16456,  16618,  16771,  16912,
+         17045,  17166,  17278,  17379,  17469,  17550,  17619,  17678,  17726,  17763,  17790,  17806,
+         17812,  17806,  17790,  17763,  17726,  17678,  17619,  17550,  17469,  17379,  17278,  17166,
+         17045,  16912,  16771,  16618,  16456,  16284,  16101,  15910,  15708,  15498,  15277,  15048,
+         14810,  14563,  14307,  14042,  13768,  13487,  13198,  12900,  12595,  12282,  11962,  11634,
+         11299,  10958,  10610,  10256,   9895,   9529,   9157,   8779,   8396,   8008,   7616,   7218,
+          6816,   6410,   6001,   5587,   5171,   4750,   4328,   3902,   3475,   3045,   2614,   2180,
+          1746,   1310,    874,    437,
+    },
+};
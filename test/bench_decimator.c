@@ -0,0 +1,55 @@
+// bench_decimator.c
+// Benchmark: cycles per control-rate output of the CIC decimator
+
+#include <stdio.h>
+#include <stdint.h>
+#include "../include/decimator.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define BENCH_OUTPUTS 4096         // Outputs per measurement
+#define BENCH_BLOCK CIC_DECIMATION // One DMA block = one output
+
+static uint16_t bench_input[BENCH_BLOCK];
+static volatile uint16_t bench_sink;  // Keeps the compiler from dropping the work
+
+// ============================================================
+// DECIMATOR BENCHMARK RUNNER
+// ============================================================
+
+void run_decimator_benchmarks(void) {
+    print_test_header("DECIMATOR BENCHMARK (CIC + FIR)");
+    
+    // A noisy mid-scale block, the shape of a real capture
+    uint32_t state = 1;
+    for (int i = 0; i < BENCH_BLOCK; i++) {
+        state = state * 1664525u + 1013904223u;
+        bench_input[i] = (uint16_t)(2048 + (state >> 30));
+    }
+    
+    Decimator decimator;
+    decimator_init(&decimator);
+    uint16_t out[2];
+    uint32_t sum = 0;
+    
+    // Same block over and over, as the control stage calls it
+    uint64_t start = time_us_64();
+    for (int i = 0; i < BENCH_OUTPUTS; i++) {
+        if (decimator_process(&decimator, bench_input, BENCH_BLOCK, out) > 0) {
+            sum += out[0];
+        }
+    }
+    uint64_t elapsed_us = time_us_64() - start;
+    bench_sink = (uint16_t)sum;
+    
+    float cycles_per_us = (float)clock_get_hz(clk_sys) / 1000000.0f;
+    float cycles_per_output = (float)elapsed_us * cycles_per_us / (float)BENCH_OUTPUTS;
+    
+    printf("  %-20s %7.1f cycles/output\n", "decimator_process", cycles_per_output);
+    printf("  %-20s %7.2f cycles/ADC sample\n", "", cycles_per_output / (float)CIC_DECIMATION);
+}
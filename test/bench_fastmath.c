@@ -0,0 +1,67 @@
+// bench_fastmath.c
+// Benchmark: cycles per call of libm powf/log2f vs the fast versions
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include "../include/fastmath.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define BENCH_CALLS 100000         // Calls per measurement
+#define BENCH_INPUTS 256           // Distinct inputs, cycled
+
+static float bench_inputs[BENCH_INPUTS];
+static volatile float bench_sink;  // Keeps the compiler from dropping the calls
+
+// ============================================================
+// MEASUREMENT
+// ============================================================
+
+typedef float (*BenchFunction)(float x);
+
+static float call_powf(float x) { return powf(2.0f, x); }
+static float call_log2f(float x) { return log2f(x); }
+
+// Call function BENCH_CALLS times and return the average cost in CPU
+// cycles per call (loop overhead included)
+static float measure_cycles_per_call(BenchFunction function) {
+    float sum = 0.0f;
+    
+    uint64_t start = time_us_64();
+    for (int i = 0; i < BENCH_CALLS; i++) {
+        sum += function(bench_inputs[i & (BENCH_INPUTS - 1)]);
+    }
+    uint64_t elapsed_us = time_us_64() - start;
+    bench_sink = sum;
+    
+    float cycles_per_us = (float)clock_get_hz(clk_sys) / 1000000.0f;
+    return (float)elapsed_us * cycles_per_us / (float)BENCH_CALLS;
+}
+
+// ============================================================
+// FAST MATH BENCHMARK RUNNER
+// ============================================================
+
+void run_fastmath_benchmarks(void) {
+    print_test_header("FAST MATH BENCHMARK (libm vs table)");
+    
+    // exp2 inputs: the 5 octaves of adc_value_to_frequency()
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        bench_inputs[i] = 5.0f * (float)i / (float)BENCH_INPUTS;
+    }
+    printf("  %-20s %7.1f cycles/call\n", "powf(2, x)", measure_cycles_per_call(call_powf));
+    printf("  %-20s %7.1f cycles/call\n", "fast_exp2f(x)", measure_cycles_per_call(fast_exp2f));
+    
+    // log2 inputs: the theremin's frequency range
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        bench_inputs[i] = 65.41f * fast_exp2f(bench_inputs[i]);
+    }
+    printf("  %-20s %7.1f cycles/call\n", "log2f(x)", measure_cycles_per_call(call_log2f));
+    printf("  %-20s %7.1f cycles/call\n", "fast_log2f(x)", measure_cycles_per_call(fast_log2f));
+}
@@ -0,0 +1,61 @@
+// bench_resampler.c
+// Benchmark: cycles per output sample of the polyphase resampler,
+// 44.1 kHz synthesis → 20 kHz PWM rate, per quality preset
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include "../include/resampler.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define BENCH_BLOCK_SIZE 256       // AUDIO_BUFFER_SIZE at 44.1 kHz
+#define BENCH_BLOCKS 512           // Blocks per measurement
+#define BENCH_INPUT_RATE 44100.0f
+#define BENCH_OUTPUT_RATE 20000.0f
+
+static int16_t bench_input[BENCH_BLOCK_SIZE];
+static int16_t bench_output[BENCH_BLOCK_SIZE];
+static Resampler bench_resampler;
+static volatile int16_t bench_sink;   // Keeps the compiler from dropping the work
+
+static const char* preset_names[] = { "RESAMPLER_FAST", "RESAMPLER_MEDIUM", "RESAMPLER_HIGH" };
+
+// ============================================================
+// RESAMPLER BENCHMARK RUNNER
+// ============================================================
+
+void run_resampler_benchmarks(void) {
+    print_test_header("RESAMPLER BENCHMARK (44.1 kHz -> 20 kHz)");
+
+    for (int i = 0; i < BENCH_BLOCK_SIZE; i++) {
+        bench_input[i] = (int16_t)(16384.0f * sinf((float)i * 0.1f));
+    }
+
+    float cycles_per_us = (float)clock_get_hz(clk_sys) / 1000000.0f;
+    // Budget: one core's cycles per output sample at the PWM rate
+    float budget = (float)clock_get_hz(clk_sys) / BENCH_OUTPUT_RATE;
+
+    for (int q = RESAMPLER_FAST; q <= RESAMPLER_HIGH; q++) {
+        resampler_init(&bench_resampler, BENCH_INPUT_RATE, BENCH_OUTPUT_RATE, (ResamplerQuality)q);
+        size_t outputs = 0;
+
+        uint64_t start = time_us_64();
+        for (int n = 0; n < BENCH_BLOCKS; n++) {
+            outputs += resampler_process(&bench_resampler, bench_input, BENCH_BLOCK_SIZE,
+                                         bench_output, BENCH_BLOCK_SIZE);
+        }
+        uint64_t elapsed_us = time_us_64() - start;
+        bench_sink = bench_output[0];
+
+        float cycles_per_output = (float)elapsed_us * cycles_per_us / (float)outputs;
+        printf("  %-18s %3u taps %7.1f cycles/output (%4.1f%% of a core)\n",
+               preset_names[q], (unsigned)bench_resampler.taps, cycles_per_output,
+               100.0f * cycles_per_output / budget);
+    }
+}
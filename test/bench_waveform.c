@@ -0,0 +1,83 @@
+// bench_waveform.c
+// Benchmark: cycles per sample of the wavetable path vs the PolyBLEP path
+
+#include <stdio.h>
+#include <stdint.h>
+#include "../include/waveform.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define BENCH_BLOCK_SIZE 256       // Same as AUDIO_BUFFER_SIZE
+#define BENCH_BLOCKS 2000          // ~11.6 s of audio per measurement
+#define BENCH_FREQUENCY 1234.5f    // Upper register, where aliasing matters
+
+static float bench_buffer[BENCH_BLOCK_SIZE];
+
+// ============================================================
+// MEASUREMENT
+// ============================================================
+
+// Render BENCH_BLOCKS blocks and return the average cost in CPU cycles
+// per output sample
+static float measure_cycles_per_sample(WaveformType type, InterpolationMode mode) {
+    Oscillator osc;
+    oscillator_init(&osc, type);
+    oscillator_set_interpolation(&osc, mode);
+    oscillator_set_frequency(&osc, BENCH_FREQUENCY);
+
+    // Warm up (caches, flash XIP)
+    oscillator_render_block(&osc, bench_buffer, BENCH_BLOCK_SIZE);
+
+    uint64_t start = time_us_64();
+    for (int block = 0; block < BENCH_BLOCKS; block++) {
+        oscillator_render_block(&osc, bench_buffer, BENCH_BLOCK_SIZE);
+    }
+    uint64_t elapsed_us = time_us_64() - start;
+
+    float cycles_per_us = (float)clock_get_hz(clk_sys) / 1000000.0f;
+    float samples = (float)BENCH_BLOCKS * (float)BENCH_BLOCK_SIZE;
+
+    return (float)elapsed_us * cycles_per_us / samples;
+}
+
+static void print_result(const char* name, float cycles) {
+    // Budget at 44.1 kHz is clk_sys / SAMPLE_RATE cycles per sample
+    float budget = (float)clock_get_hz(clk_sys) / (float)SAMPLE_RATE;
+    printf("  %-28s %7.1f cycles/sample  (%4.1f%% of budget)\n",
+           name, cycles, 100.0f * cycles / budget);
+}
+
+// ============================================================
+// WAVEFORM BENCHMARK RUNNER
+// ============================================================
+
+void run_waveform_benchmarks(void) {
+    print_test_header("WAVEFORM BENCHMARK (table vs PolyBLEP)");
+
+    waveform_init();
+
+    printf("\n  Wavetable (mipmapped, linear interpolation):\n");
+    print_result("Square table",
+                 measure_cycles_per_sample(WAVEFORM_SQUARE, INTERP_LINEAR));
+    print_result("Sawtooth table",
+                 measure_cycles_per_sample(WAVEFORM_SAWTOOTH, INTERP_LINEAR));
+    print_result("Triangle table",
+                 measure_cycles_per_sample(WAVEFORM_TRIANGLE, INTERP_LINEAR));
+
+    printf("\n  Wavetable (Hermite interpolation):\n");
+    print_result("Sawtooth table (Hermite)",
+                 measure_cycles_per_sample(WAVEFORM_SAWTOOTH, INTERP_HERMITE));
+
+    printf("\n  Analytic (PolyBLEP / PolyBLAMP):\n");
+    print_result("Square BLEP",
+                 measure_cycles_per_sample(WAVEFORM_SQUARE_BLEP, INTERP_NONE));
+    print_result("Sawtooth BLEP",
+                 measure_cycles_per_sample(WAVEFORM_SAWTOOTH_BLEP, INTERP_NONE));
+    print_result("Triangle BLAMP",
+                 measure_cycles_per_sample(WAVEFORM_TRIANGLE_BLEP, INTERP_NONE));
+}
@@ -0,0 +1,27 @@
+// hardware/clocks.h (host stand-in)
+// clk_sys reads as the RP2350's default 150 MHz, so the benchmarks'
+// "cycles" are host time at that clock: good for comparing one
+// implementation with another, not for the device's cycle budget
+
+#ifndef HOST_HARDWARE_CLOCKS_H
+#define HOST_HARDWARE_CLOCKS_H
+
+#include <stdint.h>
+
+#define HOST_CLOCK_SYS_HZ 150000000u
+
+enum clock_index {
+    clk_ref = 0,
+    clk_sys,
+    clk_adc
+};
+
+static inline uint32_t clock_get_hz(enum clock_index clock) {
+    switch (clock) {
+        case clk_sys: return HOST_CLOCK_SYS_HZ;
+        case clk_adc: return 48000000u;
+        default:      return 12000000u;   // clk_ref from the crystal
+    }
+}
+
+#endif // HOST_HARDWARE_CLOCKS_H
@@ -0,0 +1,20 @@
+// pico/stdlib.h (host stand-in)
+// The little of the Pico SDK's stdlib the tests and the HOST_TEST
+// modules use, for running the test suites on a PC (see run_tests.sh)
+
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/time.h"
+
+typedef unsigned int uint;
+
+static inline void stdio_init_all(void) {
+}
+
+static inline void tight_loop_contents(void) {
+}
+
+#endif // HOST_PICO_STDLIB_H
@@ -0,0 +1,25 @@
+// pico/time.h (host stand-in)
+// The microsecond timer, from the host's monotonic clock
+
+#ifndef HOST_PICO_TIME_H
+#define HOST_PICO_TIME_H
+
+#include <stdint.h>
+#include <time.h>
+
+static inline uint64_t time_us_64(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
+
+static inline void sleep_us(uint64_t us) {
+    struct timespec wait = { (time_t)(us / 1000000u), (long)(us % 1000000u) * 1000 };
+    nanosleep(&wait, NULL);
+}
+
+static inline void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+#endif // HOST_PICO_TIME_H
@@ -0,0 +1,45 @@
+#!/bin/sh
+# run_tests.sh
+# Builds and runs every test suite on the host (no Pico SDK needed)
+# The modules are compiled with -DHOST_TEST, which swaps the DMA, FC0
+# and second-core code for the stand-ins the tests drive; the headers
+# in test/host stand in for the few SDK calls the tests make.
+#
+# Usage: test/host/run_tests.sh [--bench] [--tsan]
+#   --bench  Also run the benchmarks (host timings, see hardware/clocks.h)
+#   --tsan   Build with ThreadSanitizer (checks the audio ring and the
+#            two-core pipeline tests, which run a real second thread)
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+BUILD="$ROOT/_host_build"
+CC=${CC:-cc}
+CFLAGS="-std=gnu11 -O2 -g -Wall -Wextra -DHOST_TEST"
+RUN_ARGS=""
+
+for arg in "$@"; do
+    case "$arg" in
+        --bench) RUN_ARGS="--bench" ;;
+        --tsan)  CFLAGS="$CFLAGS -O1 -fsanitize=thread" ;;
+        *)       echo "usage: $0 [--bench] [--tsan]" >&2; exit 2 ;;
+    esac
+done
+
+# Library modules only: main.c, audio_output.c, rod_input.c and
+# sound_profiles.c are device programs
+MODULES="fastmath waveform wavetables autotune tuning control adc_capture
+         freq_counter decimator pwm_stream audio_ring pipeline resampler
+         noise_shaper"
+TESTS="waveform fastmath autotune control adc_capture freq_counter decimator
+       pwm_stream audio_ring pipeline resampler noise_shaper"
+BENCHMARKS="fastmath waveform decimator resampler"
+
+SOURCES="$ROOT/test/host/test_main.c $ROOT/test/test_utils.c"
+for m in $MODULES; do SOURCES="$SOURCES $ROOT/src/$m.c"; done
+for t in $TESTS; do SOURCES="$SOURCES $ROOT/test/test_$t.c"; done
+for b in $BENCHMARKS; do SOURCES="$SOURCES $ROOT/test/bench_$b.c"; done
+
+mkdir -p "$BUILD"
+$CC $CFLAGS -I"$ROOT/test/host" $SOURCES -o "$BUILD/host_tests" -lm -lpthread
+"$BUILD/host_tests" $RUN_ARGS
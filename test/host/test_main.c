@@ -0,0 +1,69 @@
+// test_main.c
+// Runs every test suite on the host, against the HOST_TEST stand-ins
+// (see run_tests.sh). With --bench, runs the benchmarks afterwards.
+// Returns: the number of failed tests (0 = all passed)
+
+#include <stdio.h>
+#include <string.h>
+#include "../../include/test_utils.h"
+
+// ============================================================
+// SUITES
+// ============================================================
+
+void run_waveform_tests(int* total, int* passed, int* failed);
+void run_fastmath_tests(int* total, int* passed, int* failed);
+void run_autotune_tests(int* total, int* passed, int* failed);
+void run_control_tests(int* total, int* passed, int* failed);
+void run_adc_capture_tests(int* total, int* passed, int* failed);
+void run_freq_counter_tests(int* total, int* passed, int* failed);
+void run_decimator_tests(int* total, int* passed, int* failed);
+void run_pwm_stream_tests(int* total, int* passed, int* failed);
+void run_audio_ring_tests(int* total, int* passed, int* failed);
+void run_pipeline_tests(int* total, int* passed, int* failed);
+void run_resampler_tests(int* total, int* passed, int* failed);
+void run_noise_shaper_tests(int* total, int* passed, int* failed);
+
+void run_fastmath_benchmarks(void);
+void run_waveform_benchmarks(void);
+void run_decimator_benchmarks(void);
+void run_resampler_benchmarks(void);
+
+// ============================================================
+// MAIN
+// ============================================================
+
+int main(int argc, char** argv) {
+    bool benchmarks = (argc > 1 && strcmp(argv[1], "--bench") == 0);
+
+    int total = 0;
+    int passed = 0;
+    int failed = 0;
+
+    // STEP 1: Every suite, in the order the modules were added
+    run_waveform_tests(&total, &passed, &failed);
+    run_fastmath_tests(&total, &passed, &failed);
+    run_autotune_tests(&total, &passed, &failed);
+    run_control_tests(&total, &passed, &failed);
+    run_adc_capture_tests(&total, &passed, &failed);
+    run_freq_counter_tests(&total, &passed, &failed);
+    run_decimator_tests(&total, &passed, &failed);
+    run_pwm_stream_tests(&total, &passed, &failed);
+    run_audio_ring_tests(&total, &passed, &failed);
+    run_pipeline_tests(&total, &passed, &failed);
+    run_resampler_tests(&total, &passed, &failed);
+    run_noise_shaper_tests(&total, &passed, &failed);
+
+    print_test_summary(total, passed, failed);
+
+    // STEP 2: Benchmarks (timed with the host clock; see
+    // host/hardware/clocks.h for what the cycle counts mean here)
+    if (benchmarks) {
+        run_fastmath_benchmarks();
+        run_waveform_benchmarks();
+        run_decimator_benchmarks();
+        run_resampler_benchmarks();
+    }
+
+    return failed;
+}
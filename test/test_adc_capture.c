@@ -0,0 +1,174 @@
+// test_adc_capture.c
+// Test bench for the DMA ADC capture, using the host stand-in
+// (recorded traces go through the same API as the DMA blocks)
+
+#include <stdio.h>
+#include <math.h>
+#include <stdint.h>
+#include "../include/adc_capture.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define TRACE_LENGTH (ADC_CAPTURE_BLOCK_SIZE * 10 + 37)  // Not a whole number of blocks
+
+static uint16_t trace[TRACE_LENGTH];
+
+// A stand-in for a recorded antenna trace: slow hand movement plus
+// a little noise, 12-bit
+static void make_trace(void) {
+    for (int i = 0; i < TRACE_LENGTH; i++) {
+        float hand = 2048.0f + 1500.0f * sinf((float)i * 0.0007f);
+        float noise = (float)((i * 7919) % 17) - 8.0f;
+        trace[i] = (uint16_t)(hand + noise);
+    }
+}
+
+// ============================================================
+// ADC CAPTURE UNIT TESTS
+// ============================================================
+
+// Test 1: Blocks come out whole, in order, with the trace's samples
+bool test_adc_capture_blocks_in_order(void) {
+    printf("  Testing DMA capture block order...\n");
+    
+    make_trace();
+    AdcCapture capture;
+    adc_capture_init(&capture, 0, 50000.0f);
+    adc_capture_start(&capture);
+    
+    // Feed in uneven chunks (like a DMA running while the consumer
+    // polls at odd moments), taking blocks as they complete
+    size_t fed = 0;
+    size_t checked = 0;
+    size_t chunk = 1;
+    while (fed < TRACE_LENGTH) {
+        size_t n = (TRACE_LENGTH - fed < chunk) ? TRACE_LENGTH - fed : chunk;
+        adc_capture_feed(&capture, &trace[fed], n);
+        fed += n;
+        chunk = (chunk * 3) % 200 + 1;   // Always less than a block
+        
+        const uint16_t* block = adc_capture_acquire(&capture);
+        if (block != NULL) {
+            for (int i = 0; i < ADC_CAPTURE_BLOCK_SIZE; i++) {
+                TEST_ASSERT_EQUAL(trace[checked + i], block[i], "Block should hold the trace samples");
+            }
+            checked += ADC_CAPTURE_BLOCK_SIZE;
+        }
+    }
+    
+    TEST_ASSERT_EQUAL(10, capture.blocks_acquired, "Every complete block should be handed out once");
+    TEST_ASSERT_EQUAL(10 * ADC_CAPTURE_BLOCK_SIZE, checked, "All complete samples should be seen");
+    
+    adc_capture_stop(&capture);
+    TEST_PASS("DMA capture block order");
+}
+
+// Test 2: Nothing before the first block completes, nothing twice
+bool test_adc_capture_no_partial_blocks(void) {
+    printf("  Testing DMA capture hands out only complete blocks...\n");
+    
+    make_trace();
+    AdcCapture capture;
+    adc_capture_init(&capture, 0, 50000.0f);
+    
+    // Not started: feeding does nothing
+    adc_capture_feed(&capture, trace, ADC_CAPTURE_BLOCK_SIZE);
+    TEST_ASSERT(adc_capture_acquire(&capture) == NULL, "Stopped capture should give nothing");
+    
+    adc_capture_start(&capture);
+    adc_capture_feed(&capture, trace, ADC_CAPTURE_BLOCK_SIZE - 1);
+    TEST_ASSERT(adc_capture_acquire(&capture) == NULL, "Partial first block should not be handed out");
+    
+    adc_capture_feed(&capture, &trace[ADC_CAPTURE_BLOCK_SIZE - 1], 1);
+    const uint16_t* block = adc_capture_acquire(&capture);
+    TEST_ASSERT(block != NULL, "Completed block should be handed out");
+    TEST_ASSERT(adc_capture_acquire(&capture) == NULL, "Same block should not be handed out twice");
+    
+    // Zero-copy: the block is the DMA buffer itself
+    TEST_ASSERT(block == capture.blocks[0], "Block should point into the capture buffer");
+    
+    adc_capture_stop(&capture);
+    TEST_PASS("DMA capture complete blocks only");
+}
+
+// Test 3: One ADC, so one capture at a time (pitch, then volume)
+bool test_adc_capture_one_at_a_time(void) {
+    printf("  Testing one DMA capture at a time...\n");
+    
+    make_trace();
+    static AdcCapture pitch;
+    static AdcCapture volume;
+    adc_capture_init(&pitch, 0, 50000.0f);
+    adc_capture_init(&volume, 1, 50000.0f);
+    
+    // Each gets its own buffer, aligned for the DMA write ring
+    TEST_ASSERT(pitch.blocks[0] != volume.blocks[0], "Captures should not share a buffer");
+    TEST_ASSERT(((uintptr_t)pitch.blocks[0] % (ADC_CAPTURE_BLOCKS * ADC_CAPTURE_BLOCK_BYTES)) == 0,
+                "Buffer should be aligned for the write ring");
+    TEST_ASSERT(((uintptr_t)volume.blocks[0] % (ADC_CAPTURE_BLOCKS * ADC_CAPTURE_BLOCK_BYTES)) == 0,
+                "Buffer should be aligned for the write ring");
+    
+    // The second start is refused while the first holds the ADC
+    TEST_ASSERT(adc_capture_start(&pitch), "First capture should start");
+    TEST_ASSERT(!adc_capture_start(&volume), "Second capture should be refused while the first runs");
+    
+    // Stopping a capture that isn't running leaves the ADC alone
+    adc_capture_stop(&volume);
+    adc_capture_feed(&pitch, trace, ADC_CAPTURE_BLOCK_SIZE);
+    const uint16_t* pitch_block = adc_capture_acquire(&pitch);
+    TEST_ASSERT(pitch_block != NULL, "Running capture should complete a block");
+    for (int i = 0; i < ADC_CAPTURE_BLOCK_SIZE; i++) {
+        TEST_ASSERT_EQUAL(trace[i], pitch_block[i], "Pitch block should hold the pitch trace");
+    }
+    
+    // The refused capture got nothing
+    adc_capture_feed(&volume, trace, ADC_CAPTURE_BLOCK_SIZE);
+    TEST_ASSERT(adc_capture_acquire(&volume) == NULL, "Refused capture should give nothing");
+    
+    // Once the first stops, the second can take the ADC
+    adc_capture_stop(&pitch);
+    TEST_ASSERT(adc_capture_start(&volume), "Second capture should start once the first stops");
+    uint16_t inverted[ADC_CAPTURE_BLOCK_SIZE];
+    for (int i = 0; i < ADC_CAPTURE_BLOCK_SIZE; i++) {
+        inverted[i] = (uint16_t)(4095 - trace[i]);
+    }
+    adc_capture_feed(&volume, inverted, ADC_CAPTURE_BLOCK_SIZE);
+    const uint16_t* volume_block = adc_capture_acquire(&volume);
+    TEST_ASSERT(volume_block != NULL, "Second capture should complete a block");
+    for (int i = 0; i < ADC_CAPTURE_BLOCK_SIZE; i++) {
+        TEST_ASSERT_EQUAL(inverted[i], volume_block[i], "Volume block should hold the volume trace");
+        TEST_ASSERT_EQUAL(trace[i], pitch_block[i], "Pitch buffer should be left alone");
+    }
+    
+    adc_capture_stop(&volume);
+    TEST_PASS("One DMA capture at a time");
+}
+
+// ============================================================
+// ADC CAPTURE TEST SUITE RUNNER
+// ============================================================
+
+void run_adc_capture_tests(int* total, int* passed, int* failed) {
+    print_test_header("ADC CAPTURE TEST SUITE");
+    
+    int tests_passed = 0;
+    int tests_failed = 0;
+    int total_tests = 0;
+    
+    // Run all tests
+    RUN_TEST(test_adc_capture_blocks_in_order);
+    RUN_TEST(test_adc_capture_no_partial_blocks);
+    RUN_TEST(test_adc_capture_one_at_a_time);
+    
+    // Update totals
+    *total += total_tests;
+    *passed += tests_passed;
+    *failed += tests_failed;
+    
+    printf("\nADC Capture Suite: %d/%d tests passed\n", 
+           tests_passed, total_tests);
+}
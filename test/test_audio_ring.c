@@ -0,0 +1,181 @@
+// test_audio_ring.c
+// Test bench for the SPSC audio block ring
+// (the stress test runs the producer and consumer on two host threads;
+// link with -lpthread)
+
+#include <stdio.h>
+#include <pthread.h>
+#include <time.h>
+#include "../include/audio_ring.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define STRESS_BLOCKS 200000       // Blocks through the ring per stress run
+
+// Sample i of block n: a pattern that shows any torn, repeated or
+// skipped block
+static int16_t pattern(uint32_t block, int i) {
+    return (int16_t)((block * 31u + (uint32_t)i) & 0x7FFF);
+}
+
+// ============================================================
+// AUDIO RING UNIT TESTS
+// ============================================================
+
+// Test 1: Blocks come out in order, read in place
+bool test_audio_ring_order(void) {
+    printf("  Testing audio ring order...\n");
+
+    static AudioRing ring;
+    audio_ring_init(&ring);
+
+    // Many times round the ring (and across the slot wrap)
+    for (uint32_t n = 0; n < 10 * AUDIO_RING_BLOCKS; n++) {
+        int16_t* block = audio_ring_acquire_write(&ring);
+        TEST_ASSERT(block != NULL, "Ring should have space");
+        for (int i = 0; i < AUDIO_RING_BLOCK_SIZE; i++) {
+            block[i] = pattern(n, i);
+        }
+        audio_ring_commit_write(&ring);
+
+        const int16_t* read = audio_ring_acquire_read(&ring);
+        TEST_ASSERT(read == block, "Consumer should get the producer's block (no copy)");
+        for (int i = 0; i < AUDIO_RING_BLOCK_SIZE; i++) {
+            TEST_ASSERT_EQUAL(pattern(n, i), read[i], "Samples should arrive intact");
+        }
+        audio_ring_release_read(&ring);
+    }
+
+    TEST_ASSERT_EQUAL(0, ring.overruns, "No overruns");
+    TEST_ASSERT_EQUAL(0, ring.underruns, "No underruns");
+
+    TEST_PASS("Audio ring order");
+}
+
+// Test 2: Full and empty are reported and counted
+bool test_audio_ring_full_empty(void) {
+    printf("  Testing audio ring full/empty counters...\n");
+
+    static AudioRing ring;
+    audio_ring_init(&ring);
+
+    TEST_ASSERT(audio_ring_acquire_read(&ring) == NULL, "Empty ring has nothing to read");
+    TEST_ASSERT_EQUAL(1, ring.underruns, "Underrun counted");
+    TEST_ASSERT_EQUAL(0, audio_ring_available(&ring), "Checking doesn't count");
+    TEST_ASSERT_EQUAL(1, ring.underruns, "Still one underrun");
+
+    for (int n = 0; n < AUDIO_RING_BLOCKS; n++) {
+        TEST_ASSERT(audio_ring_acquire_write(&ring) != NULL, "Ring should have space");
+        audio_ring_commit_write(&ring);
+    }
+    TEST_ASSERT_EQUAL(0, audio_ring_space(&ring), "Ring should be full");
+    TEST_ASSERT(audio_ring_acquire_write(&ring) == NULL, "Full ring has no space");
+    TEST_ASSERT_EQUAL(1, ring.overruns, "Overrun counted");
+    TEST_ASSERT_EQUAL(AUDIO_RING_BLOCKS, audio_ring_available(&ring), "All blocks readable");
+
+    // One block back makes one block of space
+    audio_ring_acquire_read(&ring);
+    audio_ring_release_read(&ring);
+    TEST_ASSERT_EQUAL(1, audio_ring_space(&ring), "Released block is free again");
+
+    TEST_PASS("Audio ring full/empty counters");
+}
+
+// ============================================================
+// TWO-THREAD STRESS TEST
+// ============================================================
+
+static AudioRing stress_ring;
+static volatile uint32_t stress_errors;
+
+// Give the other thread the CPU (needed on single-core hosts, where a
+// plain spin would burn a whole time slice per poll)
+static void stress_wait(void) {
+    struct timespec pause = { 0, 1000 };
+    nanosleep(&pause, NULL);
+}
+
+static void* stress_producer(void* arg) {
+    (void)arg;
+    for (uint32_t n = 0; n < STRESS_BLOCKS; n++) {
+        int16_t* block;
+        while ((block = audio_ring_acquire_write(&stress_ring)) == NULL) {
+            stress_wait();   // The consumer frees a block soon
+        }
+        for (int i = 0; i < AUDIO_RING_BLOCK_SIZE; i++) {
+            block[i] = pattern(n, i);
+        }
+        audio_ring_commit_write(&stress_ring);
+    }
+    return NULL;
+}
+
+static void* stress_consumer(void* arg) {
+    (void)arg;
+    uint32_t errors = 0;
+    for (uint32_t n = 0; n < STRESS_BLOCKS; n++) {
+        const int16_t* block;
+        while ((block = audio_ring_acquire_read(&stress_ring)) == NULL) {
+            stress_wait();   // The producer commits a block soon
+        }
+        for (int i = 0; i < AUDIO_RING_BLOCK_SIZE; i++) {
+            if (block[i] != pattern(n, i)) {
+                errors++;
+            }
+        }
+        audio_ring_release_read(&stress_ring);
+    }
+    stress_errors = errors;
+    return NULL;
+}
+
+// Test 3: Producer and consumer on two threads, every block intact
+bool test_audio_ring_two_threads(void) {
+    printf("  Testing audio ring with two threads (%d blocks)...\n", STRESS_BLOCKS);
+
+    audio_ring_init(&stress_ring);
+    stress_errors = 0;
+
+    pthread_t producer, consumer;
+    pthread_create(&consumer, NULL, stress_consumer, NULL);
+    pthread_create(&producer, NULL, stress_producer, NULL);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+
+    printf("  Overruns: %u, underruns: %u (polls that found the ring full/empty)\n",
+           stress_ring.overruns, stress_ring.underruns);
+    TEST_ASSERT_EQUAL(0, stress_errors, "No torn, skipped or repeated blocks");
+    TEST_ASSERT_EQUAL(STRESS_BLOCKS, stress_ring.head, "Every block committed");
+    TEST_ASSERT_EQUAL(STRESS_BLOCKS, stress_ring.tail, "Every block released");
+
+    TEST_PASS("Audio ring with two threads");
+}
+
+// ============================================================
+// AUDIO RING TEST SUITE RUNNER
+// ============================================================
+
+void run_audio_ring_tests(int* total, int* passed, int* failed) {
+    print_test_header("AUDIO RING TEST SUITE");
+
+    int tests_passed = 0;
+    int tests_failed = 0;
+    int total_tests = 0;
+
+    // Run all tests
+    RUN_TEST(test_audio_ring_order);
+    RUN_TEST(test_audio_ring_full_empty);
+    RUN_TEST(test_audio_ring_two_threads);
+
+    // Update totals
+    *total += total_tests;
+    *passed += tests_passed;
+    *failed += tests_failed;
+
+    printf("\nAudio Ring Suite: %d/%d tests passed\n",
+           tests_passed, total_tests);
+}
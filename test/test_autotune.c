@@ -3,6 +3,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
 #include "../include/autotune.h"
 #include "../include/test_utils.h"
 #include "pico/stdlib.h"
@@ -252,6 +253,535 @@ bool test_autotune_rapid_changes(void) {
     TEST_PASS("Auto-tune rapid changes");
 }
 
+// Test 11: Fast find_nearest_note matches the reference scan
+bool test_find_nearest_note_matches_reference(void) {
+    printf("  Testing fast find_nearest_note against the linear scan...\n");
+    
+    autotune_init();
+    
+    // Sweep well past both ends of the range in ~1/100 semitone steps,
+    // so every note boundary is crossed many times
+    int checked = 0;
+    for (float freq = 20.0f; freq < 6000.0f; freq *= 1.0006f) {
+        float fast = find_nearest_note(freq);
+        float reference = find_nearest_note_reference(freq);
+        
+        if (fast != reference) {
+            printf("  Mismatch at %.3f Hz: fast %.3f, reference %.3f\n",
+                   freq, fast, reference);
+        }
+        TEST_ASSERT(fast == reference, "Fast lookup should pick the same note");
+        checked++;
+    }
+    
+    printf("  %d frequencies checked\n", checked);
+    
+    TEST_PASS("Find nearest note (fast vs reference)");
+}
+
+// Test 12: Scale quantization
+bool test_scale_quantization(void) {
+    printf("  Testing scale quantization...\n");
+    
+    autotune_init();
+    
+    // Chromatic scale should behave exactly like find_nearest_note
+    Scale scale;
+    scale_build(&scale, SCALE_CHROMATIC, 0, NOTE_C);
+    for (float freq = 20.0f; freq < 6000.0f; freq *= 1.0006f) {
+        TEST_ASSERT(quantize_to_scale(&scale, freq) == find_nearest_note(freq),
+                    "Chromatic scale should match find_nearest_note");
+    }
+    
+    // C major: A#4 (466.16 Hz) is not in the scale, A4 is closer than B4
+    scale_build(&scale, SCALE_MAJOR, 0, NOTE_C);
+    TEST_ASSERT_FLOAT_EQUAL(440.0f, quantize_to_scale(&scale, 466.16f), 0.1f,
+                           "A#4 should snap to A4 in C major");
+    TEST_ASSERT_FLOAT_EQUAL(493.88f, quantize_to_scale(&scale, 485.0f), 0.1f,
+                           "485 Hz should snap to B4 in C major");
+    
+    // A minor pentatonic-ish check with blues in A: A C D D# E G
+    scale_build(&scale, SCALE_BLUES, 0, NOTE_A);
+    TEST_ASSERT_FLOAT_EQUAL(440.0f, quantize_to_scale(&scale, 455.0f), 0.1f,
+                           "455 Hz should snap to A4 in A blues");
+    TEST_ASSERT_FLOAT_EQUAL(523.25f, quantize_to_scale(&scale, 500.0f), 0.1f,
+                           "500 Hz should snap to C5 in A blues");
+    
+    // Every output of a custom scale (C and G only) should be a C or a G
+    scale_build(&scale, SCALE_CUSTOM, 0x0081, NOTE_C);
+    for (float freq = 60.0f; freq < 3000.0f; freq *= 1.01f) {
+        float note = quantize_to_scale(&scale, freq);
+        float semitones_from_a4 = 12.0f * log2f(note / REFERENCE_A4);
+        int pitch_class = (((int)lrintf(semitones_from_a4) + NOTE_A) % 12 + 12) % 12;
+        TEST_ASSERT(pitch_class == NOTE_C || pitch_class == NOTE_G,
+                    "Custom scale should only output its own notes");
+    }
+    
+    // process_autotune uses the active scale
+    scale_set(SCALE_MAJOR, NOTE_C);
+    reset_autotune();
+    float result = process_autotune(466.16f, 1.0f, 1.0f);
+    TEST_ASSERT_FLOAT_EQUAL(440.0f, result, 0.1f,
+                           "Auto-tune should snap to the active scale");
+    scale_set(SCALE_CHROMATIC, NOTE_C);
+    
+    TEST_PASS("Scale quantization");
+}
+
+// Test 13: Independent voices
+bool test_autotune_multiple_voices(void) {
+    printf("  Testing several auto-tune voices side by side...\n");
+    
+    autotune_init();
+    
+    // Voice 0: full correction, instant; voice 1: no correction;
+    // voice 2: full correction in C major
+    Scale c_major;
+    scale_build(&c_major, SCALE_MAJOR, 0, NOTE_C);
+    
+    AutoTuneConfig configs[3] = {
+        { 1.0f, 1.0f, NULL, 0.0f, 0.0f, 0.0f, 0.0f, GLIDE_EXPONENTIAL, NULL, 0.0f },
+        { 0.0f, 1.0f, NULL, 0.0f, 0.0f, 0.0f, 0.0f, GLIDE_EXPONENTIAL, NULL, 0.0f },
+        { 1.0f, 1.0f, &c_major, 0.0f, 0.0f, 0.0f, 0.0f, GLIDE_EXPONENTIAL, NULL, 0.0f }
+    };
+    AutoTuneState voices[3];
+    for (int i = 0; i < 3; i++) {
+        autotune_state_init(&voices[i], &configs[i]);
+    }
+    
+    float inputs[3] = { 442.0f, 442.0f, 466.16f };
+    float outputs[3];
+    process_autotune_voices(voices, inputs, outputs, 3);
+    
+    TEST_ASSERT_FLOAT_EQUAL(440.0f, outputs[0], 0.1f, "Voice 0 should snap to A4");
+    TEST_ASSERT_FLOAT_EQUAL(442.0f, outputs[1], 0.1f, "Voice 1 should pass through");
+    TEST_ASSERT_FLOAT_EQUAL(440.0f, outputs[2], 0.1f, "Voice 2 should snap in C major");
+    
+    // The wrapper voice must not have been touched
+    TEST_ASSERT_FLOAT_EQUAL(0.0f, autotune_state.last_input_freq, 0.001f,
+                           "Global voice should be untouched");
+    
+    // Resetting one voice leaves the others alone
+    reset_autotune_state(&voices[0]);
+    TEST_ASSERT_FLOAT_EQUAL(REFERENCE_A4, voices[0].current_freq, 0.001f,
+                           "Reset voice should be back at A4");
+    TEST_ASSERT_FLOAT_EQUAL(466.16f, voices[2].last_input_freq, 0.001f,
+                           "Other voices should keep their state");
+    
+    TEST_PASS("Auto-tune multiple voices");
+}
+
+// Test 14: Block processing glides in real time, at any rate
+bool test_autotune_block_rate_independent(void) {
+    printf("  Testing block auto-tune at control rate and audio rate...\n");
+    
+    autotune_init();
+    
+    // Same 10 ms glide at 1 kHz and at 44.1 kHz, from A4 toward C5
+    float rates[2] = { 1000.0f, (float)SAMPLE_RATE };
+    float after_one_tau[2];
+    
+    for (int r = 0; r < 2; r++) {
+        AutoTuneConfig config = AUTOTUNE_DEFAULT_CONFIG;
+        config.glide_ms = 10.0f;
+        config.rate_hz = rates[r];
+        
+        AutoTuneState voice;
+        autotune_state_init(&voice, &config);
+        
+        // Feed exactly 10 ms of C5 in blocks of 32
+        int samples = (int)(rates[r] * 0.010f);
+        float in[32];
+        float out[32];
+        for (int i = 0; i < 32; i++) in[i] = 523.25f;
+        
+        while (samples > 0) {
+            int count = (samples < 32) ? samples : 32;
+            process_autotune_block(&voice, in, out, count);
+            samples -= count;
+        }
+        after_one_tau[r] = voice.current_freq;
+    }
+    
+    // After one time constant: 63% of the way from A4 to C5 (3 semitones)
+    float expected = 440.0f * powf(2.0f, 3.0f * 0.632f / 12.0f);
+    TEST_ASSERT_FLOAT_EQUAL(expected, after_one_tau[0], 0.5f,
+                           "1 kHz glide should cover 63% in one time constant");
+    TEST_ASSERT_FLOAT_EQUAL(expected, after_one_tau[1], 0.5f,
+                           "44.1 kHz glide should cover 63% in one time constant");
+    
+    // Re-timing a voice refreshes its cached glide: it then glides like
+    // a voice set up with the new time and rate from the start
+    AutoTuneConfig retimed_config = AUTOTUNE_DEFAULT_CONFIG;
+    retimed_config.glide_ms = 25.0f;
+    retimed_config.rate_hz = 2000.0f;
+    AutoTuneConfig default_config = AUTOTUNE_DEFAULT_CONFIG;
+    AutoTuneState fresh;
+    AutoTuneState retimed;
+    autotune_state_init(&fresh, &retimed_config);
+    autotune_state_init(&retimed, &default_config);
+    autotune_set_glide_time(&retimed, retimed_config.glide_ms, retimed_config.rate_hz);
+    
+    float glide_in[32];
+    float fresh_out[32];
+    float retimed_out[32];
+    for (int i = 0; i < 32; i++) glide_in[i] = 523.25f;
+    process_autotune_block(&fresh, glide_in, fresh_out, 32);
+    process_autotune_block(&retimed, glide_in, retimed_out, 32);
+    for (int i = 0; i < 32; i++) {
+        TEST_ASSERT_FLOAT_EQUAL(fresh_out[i], retimed_out[i], 1e-4f,
+                               "Re-timed voice should glide at its new time");
+    }
+    
+    // Strength blend: 50% should land halfway once settled
+    AutoTuneConfig config = AUTOTUNE_DEFAULT_CONFIG;
+    config.strength = 0.5f;
+    config.glide_ms = 0.0f;
+    AutoTuneState voice;
+    autotune_state_init(&voice, &config);
+    
+    float in[4] = { 442.0f, 442.0f, 442.0f, 442.0f };
+    float out[4];
+    process_autotune_block(&voice, in, out, 4);
+    TEST_ASSERT_FLOAT_EQUAL(441.0f, out[3], 0.05f,
+                           "50% strength should give ~441 Hz");
+    
+    TEST_PASS("Auto-tune block processing");
+}
+
+// Test 15: Note-switch hysteresis and dwell time
+bool test_autotune_hysteresis(void) {
+    printf("  Testing note-switch hysteresis...\n");
+    
+    autotune_init();
+    
+    // Boundary between A4 and A#4 in cents: their geometric mean
+    float boundary = sqrtf(440.0f * 466.16f);
+    float cent = exp2f(1.0f / 1200.0f);
+    
+    AutoTuneConfig config = AUTOTUNE_DEFAULT_CONFIG;
+    config.glide_rate = 1.0f;        // Snap, so output = target
+    config.dead_zone_cents = 10.0f;
+    config.rate_hz = 1000.0f;
+    AutoTuneState voice;
+    autotune_state_init(&voice, &config);
+    
+    // Settle on A4, then jitter +/-5 cents around the boundary:
+    // the target must not chatter
+    process_autotune_state(&voice, 440.0f);
+    int switches = 0;
+    int last_note = voice.target_note;
+    for (int i = 0; i < 200; i++) {
+        float jitter = (i & 1) ? powf(cent, 5.0f) : powf(cent, -5.0f);
+        process_autotune_state(&voice, boundary * jitter);
+        if (voice.target_note != last_note) {
+            switches++;
+            last_note = voice.target_note;
+        }
+    }
+    TEST_ASSERT_EQUAL(0, switches, "Jitter inside the dead zone should not switch notes");
+    
+    // Moving clearly past the dead zone switches
+    float result = process_autotune_state(&voice, boundary * powf(cent, 12.0f));
+    TEST_ASSERT_FLOAT_EQUAL(466.16f, result, 0.1f, "12 cents past the boundary should switch");
+    
+    // Minimum dwell: 20 ms at 1 kHz = 20 samples before the next switch
+    autotune_set_hysteresis(&voice, 10.0f, 20.0f);
+    process_autotune_state(&voice, 440.0f);            // Switch back to A4
+    result = process_autotune_state(&voice, 523.25f);  // Too soon
+    TEST_ASSERT_FLOAT_EQUAL(440.0f, result, 0.1f, "Switch should wait for the dwell time");
+    
+    for (int i = 0; i < 20; i++) {
+        result = process_autotune_state(&voice, 523.25f);
+    }
+    TEST_ASSERT_FLOAT_EQUAL(523.25f, result, 0.1f, "Switch should happen after the dwell time");
+    
+    // Changing only the dead zone keeps the dwell running
+    for (int i = 0; i < 25; i++) {
+        process_autotune_state(&voice, 523.25f);
+    }
+    process_autotune_state(&voice, 440.0f);            // Switch back to A4
+    autotune_set_hysteresis(&voice, 15.0f, 20.0f);
+    result = process_autotune_state(&voice, 523.25f);  // Still too soon
+    TEST_ASSERT_FLOAT_EQUAL(440.0f, result, 0.1f, "New dead zone should not skip the dwell time");
+    
+    TEST_PASS("Auto-tune hysteresis");
+}
+
+// Test 16: Glides run in semitones, with selectable curves
+bool test_autotune_glide_curves(void) {
+    printf("  Testing pitch-domain glide curves...\n");
+    
+    autotune_init();
+    
+    GlideCurve curves[3] = { GLIDE_EXPONENTIAL, GLIDE_LINEAR, GLIDE_SCURVE };
+    
+    for (int c = 0; c < 3; c++) {
+        // Glide up an octave and down an octave: same time, mirrored
+        float up_halfway = 0.0f;
+        float down_halfway = 0.0f;
+        
+        for (int direction = 0; direction < 2; direction++) {
+            AutoTuneConfig config = AUTOTUNE_DEFAULT_CONFIG;
+            config.glide_ms = 20.0f;
+            config.rate_hz = 1000.0f;
+            config.glide_curve = curves[c];
+            AutoTuneState voice;
+            autotune_state_init(&voice, &config);
+            
+            float start = (direction == 0) ? 220.0f : 440.0f;
+            float end = (direction == 0) ? 440.0f : 220.0f;
+            float out;
+            
+            // Settle on the start note
+            autotune_set_glide_time(&voice, 0.0f, 1000.0f);
+            process_autotune_block(&voice, &start, &out, 1);
+            autotune_set_glide_time(&voice, 20.0f, 1000.0f);
+            
+            // 10 ms into the glide (10 samples at 1 kHz)
+            for (int i = 0; i < 10; i++) {
+                process_autotune_block(&voice, &end, &out, 1);
+            }
+            float semitones_moved = fabsf(12.0f * log2f(out / start));
+            if (direction == 0) up_halfway = semitones_moved;
+            else down_halfway = semitones_moved;
+            
+            // Timed curves land exactly at glide_ms
+            for (int i = 0; i < 10; i++) {
+                process_autotune_block(&voice, &end, &out, 1);
+            }
+            if (curves[c] != GLIDE_EXPONENTIAL) {
+                TEST_ASSERT_FLOAT_EQUAL(end, out, 0.05f,
+                                       "Timed glide should land after glide_ms");
+            }
+        }
+        
+        TEST_ASSERT_FLOAT_EQUAL(up_halfway, down_halfway, 0.01f,
+                               "Up and down glides should move the same semitones");
+        
+        // Halfway through: linear and S-curve are both exactly half an octave
+        if (curves[c] != GLIDE_EXPONENTIAL) {
+            TEST_ASSERT_FLOAT_EQUAL(6.0f, up_halfway, 0.01f,
+                                   "Timed glide should be halfway at glide_ms / 2");
+        }
+    }
+    
+    TEST_PASS("Auto-tune glide curves");
+}
+
+// Test 17: Scala files parse into the right note table
+bool test_tuning_scala_loader(void) {
+    printf("  Testing Scala .scl/.kbm loader...\n");
+    
+    autotune_init();
+    
+    // 12-TET written in cents, default mapping: same notes as note_table
+    const char equal_scl[] =
+        "! 12tet.scl\n"
+        "12-tone equal temperament\n"
+        "12\n"
+        "!\n"
+        " 100.0\n 200.0\n 300.0\n 400.0\n 500.0\n 600.0\n"
+        " 700.0\n 800.0\n 900.0\n 1000.0\n 1100.0\n 2/1\n";
+    ScalaScale scale;
+    Tuning tuning;
+    TEST_ASSERT(tuning_parse_scl(&scale, equal_scl, sizeof(equal_scl) - 1),
+                "12-TET .scl should parse");
+    TEST_ASSERT(scale.count == 12, "12-TET should have 12 degrees");
+    TEST_ASSERT(tuning_build(&tuning, &scale, NULL, note_table[0], note_table[NUM_NOTES - 1] * 1.001f),
+                "12-TET tuning should build");
+    TEST_ASSERT(tuning.count == NUM_NOTES, "12-TET should cover the note table");
+    for (int i = 0; i < NUM_NOTES; i++) {
+        TEST_ASSERT_FLOAT_EQUAL(note_table[i], tuning.freqs[i], note_table[i] * 0.0005f,
+                               "12-TET tuning should match note_table");
+    }
+    
+    // Just intonation blob: ratios relative to C, A4 still 440 Hz
+    TEST_ASSERT(tuning_parse_scl(&scale, tuning_just_intonation_scl,
+                                 strlen(tuning_just_intonation_scl)),
+                "Built-in just intonation should parse");
+    TEST_ASSERT(tuning_build(&tuning, &scale, NULL, 20.0f, 2000.0f), "Just tuning should build");
+    float c4 = 440.0f * 3.0f / 5.0f;   // A is the 5/3 above C
+    TEST_ASSERT_FLOAT_EQUAL(c4, tuning_nearest(&tuning, 262.0f), 0.01f, "C4 should be 264 Hz");
+    TEST_ASSERT_FLOAT_EQUAL(c4 * 1.5f, tuning_nearest(&tuning, 394.0f), 0.01f,
+                           "G4 should be a pure fifth above C4");
+    
+    // Keyboard mapping: 5-note map on the white keys C D E G A,
+    // black keys and F/B unmapped
+    const char pentatonic_kbm[] =
+        "! pentatonic.kbm\n"
+        "12\n0\n127\n60\n69\n440.0\n12\n"
+        "0\nx\n2\nx\n4\nx\nx\n7\nx\n9\nx\nx\n";
+    ScalaKeymap keymap;
+    TEST_ASSERT(tuning_parse_kbm(&keymap, pentatonic_kbm, sizeof(pentatonic_kbm) - 1),
+                "Pentatonic .kbm should parse");
+    TEST_ASSERT(tuning_build(&tuning, &scale, &keymap, 100.0f, 1000.0f),
+                "Mapped tuning should build");
+    TEST_ASSERT_FLOAT_EQUAL(c4 * 1.5f, tuning_nearest(&tuning, 370.0f), 0.01f,
+                           "F# (unmapped) should snap to G");
+    
+    // Binary search agrees with a linear scan (nearest in cents)
+    for (float f = 100.0f; f < 1000.0f; f *= 1.0021f) {
+        int best = 0;
+        for (int i = 1; i < tuning.count; i++) {
+            if (fabsf(log2f(f / tuning.freqs[i])) < fabsf(log2f(f / tuning.freqs[best]))) {
+                best = i;
+            }
+        }
+        TEST_ASSERT(tuning_nearest_index(&tuning, f) == best,
+                    "Binary search should find the nearest note in cents");
+    }
+    
+    // Broken files are rejected
+    const char truncated_scl[] = "bad\n3\n100.0\n";
+    TEST_ASSERT(!tuning_parse_scl(&scale, truncated_scl, sizeof(truncated_scl) - 1),
+                "Truncated .scl should fail");
+    
+    // So is a range with no notes in it (below MIDI key 0), without
+    // touching the tuning
+    int previous_count = tuning.count;
+    uint32_t previous_generation = tuning.generation;
+    TEST_ASSERT(!tuning_build(&tuning, &scale, NULL, 1.0f, 2.0f),
+                "Empty tuning should fail to build");
+    TEST_ASSERT(tuning.count == previous_count && tuning.generation == previous_generation,
+                "Failed build should leave the tuning as it was");
+    
+    // A tuning with no notes (never built) leaves frequencies alone
+    static Tuning empty_tuning;
+    TEST_ASSERT(tuning_nearest_index(&empty_tuning, 440.0f) == 0, "Empty tuning should give index 0");
+    TEST_ASSERT_FLOAT_EQUAL(437.0f, tuning_nearest(&empty_tuning, 437.0f), 0.0f,
+                           "Empty tuning should return the input frequency");
+    
+    TEST_PASS("Scala tuning loader");
+}
+
+// Test 18: A voice snaps to a microtonal tuning
+bool test_autotune_microtonal(void) {
+    printf("  Testing auto-tune with a microtonal tuning...\n");
+    
+    autotune_init();
+    
+    // 19-tone equal temperament: steps of 1200/19 = 63.16 cents
+    const char edo19_scl[] = "19-EDO\n1\n63.157895\n";
+    ScalaScale scale;
+    Tuning tuning;
+    TEST_ASSERT(tuning_parse_scl(&scale, edo19_scl, sizeof(edo19_scl) - 1), "19-EDO should parse");
+    
+    // One-degree period: the period is the step itself
+    ScalaKeymap keymap;
+    tuning_default_keymap(&keymap);
+    keymap.middle_note = 69;   // Degree 0 on A4
+    TEST_ASSERT(tuning_build(&tuning, &scale, &keymap, 200.0f, 900.0f), "19-EDO should build");
+    
+    AutoTuneConfig config = AUTOTUNE_DEFAULT_CONFIG;
+    config.glide_rate = 1.0f;
+    config.tuning = &tuning;
+    AutoTuneState voice;
+    autotune_state_init(&voice, &config);
+    
+    // 70 cents above A4 is nearest to one 19-EDO step up
+    float step_up = 440.0f * exp2f(63.157895f / 1200.0f);
+    float result = process_autotune_state(&voice, 440.0f * exp2f(70.0f / 1200.0f));
+    TEST_ASSERT_FLOAT_EQUAL(step_up, result, 0.1f, "Should snap to the 19-EDO step");
+    TEST_ASSERT_FLOAT_EQUAL(63.157895f / 100.0f, voice.target_pitch, 0.001f,
+                           "Target pitch should come from the tuning");
+    
+    // 20 cents up: nearer A4 than the step (63 cents), so back to A
+    for (int i = 0; i < 5; i++) {
+        result = process_autotune_state(&voice, 440.0f * exp2f(20.0f / 1200.0f));
+    }
+    TEST_ASSERT_FLOAT_EQUAL(440.0f, result, 0.1f, "Should snap back to A4");
+    
+    TEST_PASS("Auto-tune microtonal tuning");
+}
+
+// Test 19: Vibrato-preserving mode corrects the center, keeps the vibrato
+bool test_autotune_vibrato_preserving(void) {
+    printf("  Testing vibrato-preserving correction...\n");
+    
+    autotune_init();
+    
+    // Player 35 cents sharp of A4 with +/-30 cent vibrato at 5.5 Hz,
+    // processed at control rate
+    float rate = (float)SAMPLE_RATE / 256.0f;
+    float center_cents = 35.0f;
+    float depth_cents = 30.0f;
+    
+    for (int mode = 0; mode < 2; mode++) {
+        AutoTuneConfig config = AUTOTUNE_DEFAULT_CONFIG;
+        config.glide_ms = 15.0f;
+        config.rate_hz = rate;
+        config.dead_zone_cents = 15.0f;
+        config.vibrato_cutoff_hz = (mode == 1) ? 2.0f : 0.0f;
+        AutoTuneState voice;
+        autotune_state_init(&voice, &config);
+        
+        float low = 1e9f;
+        float high = -1e9f;
+        float sum = 0.0f;
+        int count = 0;
+        
+        // 4 seconds; measure the last 2 (settled)
+        int samples = (int)(4.0f * rate);
+        for (int i = 0; i < samples; i++) {
+            float cents = center_cents + depth_cents * sinf(6.2831853f * 5.5f * (float)i / rate);
+            float in = 440.0f * exp2f(cents / 1200.0f);
+            float out;
+            process_autotune_block(&voice, &in, &out, 1);
+            
+            if (i >= samples / 2) {
+                float out_cents = 1200.0f * log2f(out / 440.0f);
+                if (out_cents < low) low = out_cents;
+                if (out_cents > high) high = out_cents;
+                sum += out_cents;
+                count++;
+            }
+        }
+        float mean = sum / (float)count;
+        float depth = (high - low) * 0.5f;
+        
+        if (mode == 0) {
+            TEST_ASSERT(depth < 0.5f * depth_cents, "Plain correction should flatten vibrato");
+        } else {
+            printf("  Vibrato kept: %.1f of %.1f cents, center %.1f cents off A4\n",
+                   depth, depth_cents, mean);
+            TEST_ASSERT_FLOAT_EQUAL(0.0f, mean, 3.0f, "Center should be corrected to A4");
+            TEST_ASSERT(depth > 0.8f * depth_cents, "Vibrato depth should be preserved");
+        }
+    }
+    
+    TEST_PASS("Auto-tune vibrato preserving");
+}
+
+// Test 20: No pitch (0 Hz) gives a finite output, vibrato mode or not
+bool test_autotune_zero_input(void) {
+    printf("  Testing auto-tune with a 0 Hz input...\n");
+    
+    autotune_init();
+    
+    // Original wrapper (vibrato off)
+    float result = process_autotune(0.0f, 1.0f, 0.1f);
+    TEST_ASSERT(isfinite(result), "0 Hz should not give NaN");
+    
+    for (int mode = 0; mode < 2; mode++) {
+        AutoTuneConfig config = AUTOTUNE_DEFAULT_CONFIG;
+        config.vibrato_cutoff_hz = (mode == 1) ? 2.0f : 0.0f;
+        AutoTuneState voice;
+        autotune_state_init(&voice, &config);
+        
+        float in[4] = { 0.0f, 0.0f, 440.0f, 0.0f };
+        float out[4];
+        process_autotune_block(&voice, in, out, 4);
+        for (int i = 0; i < 4; i++) {
+            TEST_ASSERT(isfinite(out[i]), "Block output should stay finite through silence");
+        }
+        TEST_ASSERT(isfinite(process_autotune_state(&voice, 0.0f)),
+                    "Per-sample output should stay finite through silence");
+    }
+    
+    TEST_PASS("Auto-tune 0 Hz input");
+}
+
 // ============================================================
 // AUTO-TUNE TEST SUITE RUNNER
 // ============================================================
@@ -274,6 +804,16 @@ void run_autotune_tests(int* total, int* passed, int* failed) {
     RUN_TEST(test_autotune_range_limits);
     RUN_TEST(test_autotune_frequency_change);
     RUN_TEST(test_autotune_rapid_changes);
+    RUN_TEST(test_find_nearest_note_matches_reference);
+    RUN_TEST(test_scale_quantization);
+    RUN_TEST(test_autotune_multiple_voices);
+    RUN_TEST(test_autotune_block_rate_independent);
+    RUN_TEST(test_autotune_hysteresis);
+    RUN_TEST(test_autotune_glide_curves);
+    RUN_TEST(test_tuning_scala_loader);
+    RUN_TEST(test_autotune_microtonal);
+    RUN_TEST(test_autotune_vibrato_preserving);
+    RUN_TEST(test_autotune_zero_input);
     
     // Update totals
     *total += total_tests;
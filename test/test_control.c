@@ -0,0 +1,122 @@
+// test_control.c
+// Test bench for the control-rate ring buffer
+
+#include <stdio.h>
+#include <math.h>
+#include "../include/control.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+
+// ============================================================
+// CONTROL STAGE UNIT TESTS
+// ============================================================
+
+// Test 1: Points come out in order
+bool test_control_ring_order(void) {
+    printf("  Testing control ring order...\n");
+    
+    ControlRing ring;
+    ControlPoint initial = { 440.0f, 1.0f };
+    control_ring_init(&ring, initial);
+    
+    // Several blocks, across the index wrap
+    float next_in = 100.0f;
+    float next_out = 100.0f;
+    for (int block = 0; block < 20; block++) {
+        for (int i = 0; i < 8; i++) {
+            ControlPoint point = { next_in, 0.5f };
+            TEST_ASSERT(control_ring_push(&ring, &point), "Push should succeed");
+            next_in += 1.0f;
+        }
+        
+        ControlPoint out[8];
+        TEST_ASSERT_EQUAL(8, control_ring_pop(&ring, out, 8), "All 8 points should be fresh");
+        for (int i = 0; i < 8; i++) {
+            TEST_ASSERT_FLOAT_EQUAL(next_out, out[i].frequency, 0.0f, "Points should stay in order");
+            next_out += 1.0f;
+        }
+    }
+    
+    TEST_PASS("Control ring order");
+}
+
+// Test 2: An empty ring repeats the last point
+bool test_control_ring_underrun(void) {
+    printf("  Testing control ring underrun...\n");
+    
+    ControlRing ring;
+    ControlPoint initial = { 440.0f, 1.0f };
+    control_ring_init(&ring, initial);
+    
+    // Nothing pushed yet: the initial point
+    ControlPoint out[8];
+    TEST_ASSERT_EQUAL(0, control_ring_pop(&ring, out, 8), "Nothing should be fresh");
+    TEST_ASSERT_FLOAT_EQUAL(440.0f, out[7].frequency, 0.0f, "Empty ring should give the initial point");
+    
+    // Three pushed: the third is held for the rest of the block
+    for (int i = 0; i < 3; i++) {
+        ControlPoint point = { 200.0f + (float)i, 1.0f };
+        control_ring_push(&ring, &point);
+    }
+    TEST_ASSERT_EQUAL(3, control_ring_pop(&ring, out, 8), "Three points should be fresh");
+    TEST_ASSERT_FLOAT_EQUAL(202.0f, out[3].frequency, 0.0f, "Last point should be held");
+    TEST_ASSERT_FLOAT_EQUAL(202.0f, out[7].frequency, 0.0f, "Last point should be held");
+    TEST_ASSERT_EQUAL(8 + 5, ring.underruns, "Underruns should be counted");
+    
+    TEST_PASS("Control ring underrun");
+}
+
+// Test 3: A producer running ahead neither overflows silently nor adds
+// latency
+bool test_control_ring_latency_bound(void) {
+    printf("  Testing control ring latency bound...\n");
+    
+    ControlRing ring;
+    ControlPoint initial = { 440.0f, 1.0f };
+    control_ring_init(&ring, initial);
+    
+    // Fill past capacity
+    float value = 0.0f;
+    for (int i = 0; i < CONTROL_RING_SIZE + 4; i++) {
+        ControlPoint point = { value, 1.0f };
+        control_ring_push(&ring, &point);
+        value += 1.0f;
+    }
+    TEST_ASSERT_EQUAL(4, ring.overruns, "Points past capacity should be dropped");
+    
+    // Pop skips to the newest two blocks' worth
+    ControlPoint out[8];
+    control_ring_pop(&ring, out, 8);
+    TEST_ASSERT_FLOAT_EQUAL((float)(CONTROL_RING_SIZE - 16), out[0].frequency, 0.0f,
+                           "Old points should be skipped");
+    control_ring_pop(&ring, out, 8);
+    TEST_ASSERT_FLOAT_EQUAL((float)(CONTROL_RING_SIZE - 1), out[7].frequency, 0.0f,
+                           "Newest point should come out next block");
+    
+    TEST_PASS("Control ring latency bound");
+}
+
+// ============================================================
+// CONTROL STAGE TEST SUITE RUNNER
+// ============================================================
+
+void run_control_tests(int* total, int* passed, int* failed) {
+    print_test_header("CONTROL STAGE TEST SUITE");
+    
+    int tests_passed = 0;
+    int tests_failed = 0;
+    int total_tests = 0;
+    
+    // Run all tests
+    RUN_TEST(test_control_ring_order);
+    RUN_TEST(test_control_ring_underrun);
+    RUN_TEST(test_control_ring_latency_bound);
+    
+    // Update totals
+    *total += total_tests;
+    *passed += tests_passed;
+    *failed += tests_failed;
+    
+    printf("\nControl Stage Suite: %d/%d tests passed\n", 
+           tests_passed, total_tests);
+}
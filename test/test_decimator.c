@@ -0,0 +1,143 @@
+// test_decimator.c
+// Test bench for the CIC + compensation FIR decimator
+
+#include <stdio.h>
+#include <math.h>
+#include "../include/decimator.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define TEST_OUTPUTS 128
+#define TEST_INPUTS (TEST_OUTPUTS * CIC_DECIMATION)
+
+static uint16_t test_input[TEST_INPUTS];
+static uint16_t test_output[TEST_OUTPUTS + 1];
+
+// Small deterministic noise source (LCG), uniform in [-range, +range]
+static uint32_t noise_state = 12345;
+static int noise(int range) {
+    noise_state = noise_state * 1664525u + 1013904223u;
+    return (int)((noise_state >> 16) % (uint32_t)(2 * range + 1)) - range;
+}
+
+// ============================================================
+// DECIMATOR UNIT TESTS
+// ============================================================
+
+// Test 1: A constant input comes out × 16 (12.4), exactly
+bool test_decimator_dc_gain(void) {
+    printf("  Testing decimator DC gain...\n");
+    
+    for (int level = 0; level <= 4095; level += 819) {
+        Decimator decimator;
+        decimator_init(&decimator);
+        for (int i = 0; i < TEST_INPUTS; i++) {
+            test_input[i] = (uint16_t)level;
+        }
+        
+        size_t count = decimator_process(&decimator, test_input, TEST_INPUTS, test_output);
+        TEST_ASSERT_EQUAL(TEST_OUTPUTS - CIC_STAGES, count, "Warmup outputs should be dropped");
+        for (size_t i = 0; i < count; i++) {
+            TEST_ASSERT_EQUAL(level << DECIMATOR_EXTRA_BITS, test_output[i], "DC should pass × 16");
+        }
+    }
+    
+    TEST_PASS("Decimator DC gain");
+}
+
+// Test 2: Block size doesn't matter (phase carries across calls)
+bool test_decimator_block_independent(void) {
+    printf("  Testing decimator across uneven blocks...\n");
+    
+    for (int i = 0; i < TEST_INPUTS; i++) {
+        test_input[i] = (uint16_t)(2048 + (int)(1000.0f * sinf((float)i * 0.001f)) + noise(20));
+    }
+    
+    Decimator whole;
+    decimator_init(&whole);
+    size_t whole_count = decimator_process(&whole, test_input, TEST_INPUTS, test_output);
+    
+    Decimator pieces;
+    decimator_init(&pieces);
+    uint16_t piece_output[TEST_OUTPUTS + 1];
+    size_t piece_count = 0;
+    size_t position = 0;
+    size_t chunk = 7;
+    while (position < TEST_INPUTS) {
+        size_t n = (TEST_INPUTS - position < chunk) ? TEST_INPUTS - position : chunk;
+        piece_count += decimator_process(&pieces, &test_input[position], n, &piece_output[piece_count]);
+        position += n;
+        chunk = chunk * 5 % 97 + 1;
+    }
+    
+    TEST_ASSERT_EQUAL(whole_count, piece_count, "Same number of outputs");
+    for (size_t i = 0; i < whole_count; i++) {
+        TEST_ASSERT_EQUAL(test_output[i], piece_output[i], "Same outputs whatever the block size");
+    }
+    
+    TEST_PASS("Decimator block independent");
+}
+
+// Test 3: ADC noise shrinks enough for 14+ effective bits
+bool test_decimator_effective_bits(void) {
+    printf("  Testing decimator noise reduction...\n");
+    
+    // Constant level with +/-1 LSB of white noise (about 0.8 LSB rms:
+    // 10.5 effective bits per reading)
+    double input_power = 0.0;
+    for (int i = 0; i < TEST_INPUTS; i++) {
+        int n = noise(1);
+        test_input[i] = (uint16_t)(2000 + n);
+        input_power += (double)(n * n);
+    }
+    double input_rms = sqrt(input_power / TEST_INPUTS);
+    
+    Decimator decimator;
+    decimator_init(&decimator);
+    size_t count = decimator_process(&decimator, test_input, TEST_INPUTS, test_output);
+    
+    // Output noise in 12-bit LSB
+    double power = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double error = (double)test_output[i] / 16.0 - 2000.0;
+        power += error * error;
+    }
+    double output_rms = sqrt(power / (double)count);
+    
+    // Effective bits of a full-scale 12-bit range: 12 - log2(rms / (1/√12))
+    double bits = 12.0 - log2(output_rms * sqrt(12.0));
+    printf("  Noise: %.2f LSB in, %.3f LSB out → %.1f effective bits\n",
+           input_rms, output_rms, bits);
+    TEST_ASSERT(bits >= 14.0, "Decimated output should have 14+ effective bits");
+    
+    TEST_PASS("Decimator effective bits");
+}
+
+// ============================================================
+// DECIMATOR TEST SUITE RUNNER
+// ============================================================
+
+void run_decimator_tests(int* total, int* passed, int* failed) {
+    print_test_header("DECIMATOR TEST SUITE");
+    
+    int tests_passed = 0;
+    int tests_failed = 0;
+    int total_tests = 0;
+    
+    // Run all tests
+    RUN_TEST(test_decimator_dc_gain);
+    RUN_TEST(test_decimator_block_independent);
+    RUN_TEST(test_decimator_effective_bits);
+    
+    // Update totals
+    *total += total_tests;
+    *passed += tests_passed;
+    *failed += tests_failed;
+    
+    printf("\nDecimator Suite: %d/%d tests passed\n", 
+           tests_passed, total_tests);
+}
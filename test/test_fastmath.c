@@ -0,0 +1,149 @@
+// test_fastmath.c
+// Test bench for the fast exp2/log2 approximations (against libm)
+
+#include <stdio.h>
+#include <math.h>
+#include "../include/fastmath.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define SWEEP_POINTS 100000        // Points per error sweep
+
+// Error budgets in cents (see the table in fastmath.h)
+#define EXP2F_MAX_CENTS 0.03f
+#define LOG2F_MAX_CENTS 0.06f
+#define EXP2_Q16_MAX_CENTS 0.05f
+#define LOG2_Q16_MAX_CENTS 0.07f
+
+// ============================================================
+// FAST MATH UNIT TESTS
+// ============================================================
+
+// Test 1: fast_exp2f against exp2f over the pitch range and beyond
+bool test_fast_exp2f_accuracy(void) {
+    printf("  Testing fast_exp2f against libm...\n");
+    
+    double worst_cents = 0.0;
+    for (int i = 0; i <= SWEEP_POINTS; i++) {
+        float x = -20.0f + 40.0f * (float)i / (float)SWEEP_POINTS;
+        double cents = 1200.0 * fabs(log2((double)fast_exp2f(x) / exp2((double)x)));
+        if (cents > worst_cents) worst_cents = cents;
+    }
+    printf("  Max error: %.4f cents\n", worst_cents);
+    TEST_ASSERT(worst_cents < EXP2F_MAX_CENTS, "fast_exp2f should be within its error bound");
+    
+    // Exact at integers (table ends, exponent bits)
+    TEST_ASSERT(fast_exp2f(0.0f) == 1.0f, "2^0 should be exactly 1");
+    TEST_ASSERT(fast_exp2f(5.0f) == 32.0f, "2^5 should be exactly 32");
+    TEST_ASSERT(fast_exp2f(-3.0f) == 0.125f, "2^-3 should be exactly 0.125");
+    
+    TEST_PASS("fast_exp2f accuracy");
+}
+
+// Test 2: fast_log2f against log2f over the audio range
+bool test_fast_log2f_accuracy(void) {
+    printf("  Testing fast_log2f against libm...\n");
+    
+    double worst_cents = 0.0;
+    for (int i = 0; i <= SWEEP_POINTS; i++) {
+        // 1 Hz to 32 kHz, spaced evenly in pitch
+        float x = exp2f(15.0f * (float)i / (float)SWEEP_POINTS);
+        double cents = 1200.0 * fabs((double)fast_log2f(x) - log2((double)x));
+        if (cents > worst_cents) worst_cents = cents;
+    }
+    printf("  Max error: %.4f cents\n", worst_cents);
+    TEST_ASSERT(worst_cents < LOG2F_MAX_CENTS, "fast_log2f should be within its error bound");
+    
+    TEST_ASSERT(fast_log2f(1.0f) == 0.0f, "log2(1) should be exactly 0");
+    TEST_ASSERT(fast_log2f(1024.0f) == 10.0f, "log2(1024) should be exactly 10");
+    
+    // Round trip: log2 then exp2 lands back on the input
+    float freq = 329.63f;
+    TEST_ASSERT_FLOAT_EQUAL(freq, fast_exp2f(fast_log2f(freq)), freq * 1e-4f,
+                           "exp2(log2(f)) should return f");
+    
+    TEST_PASS("fast_log2f accuracy");
+}
+
+// Test 3: Fixed-point exp2 against libm
+bool test_fast_exp2_q16_accuracy(void) {
+    printf("  Testing fast_exp2_q16 against libm...\n");
+    
+    // Results >= 1.0 (x >= 0): error bound in cents
+    double worst_cents = 0.0;
+    for (int i = 0; i <= SWEEP_POINTS; i++) {
+        int32_t x = (int32_t)((int64_t)i * (15 << 16) / SWEEP_POINTS);
+        double expected = exp2((double)x / 65536.0);
+        double actual = (double)fast_exp2_q16(x) / 65536.0;
+        double cents = 1200.0 * fabs(log2(actual / expected));
+        if (cents > worst_cents) worst_cents = cents;
+    }
+    printf("  Max error (x >= 0): %.4f cents\n", worst_cents);
+    TEST_ASSERT(worst_cents < EXP2_Q16_MAX_CENTS, "fast_exp2_q16 should be within its error bound");
+    
+    // Below 1.0 the result is limited by Q16 itself: within 2 LSB
+    for (int32_t x = -(8 << 16); x < 0; x += 977) {
+        double expected = exp2((double)x / 65536.0) * 65536.0;
+        TEST_ASSERT(fabs((double)fast_exp2_q16(x) - expected) <= 2.0,
+                    "fast_exp2_q16 should be within 2 LSB below 1.0");
+    }
+    
+    TEST_ASSERT(fast_exp2_q16(0) == 65536u, "2^0 should be exactly 1.0 in Q16");
+    TEST_ASSERT(fast_exp2_q16(16 << 16) == UINT32_MAX, "2^16 should saturate");
+    
+    TEST_PASS("fast_exp2_q16 accuracy");
+}
+
+// Test 4: Fixed-point log2 against libm
+bool test_fast_log2_q16_accuracy(void) {
+    printf("  Testing fast_log2_q16 against libm...\n");
+    
+    double worst_cents = 0.0;
+    for (int i = 0; i <= SWEEP_POINTS; i++) {
+        // 1/65536 to 32768, spaced evenly in pitch
+        uint32_t x = (uint32_t)exp2(31.0 * (double)i / (double)SWEEP_POINTS);
+        double expected = log2((double)x / 65536.0);
+        double actual = (double)fast_log2_q16(x) / 65536.0;
+        double cents = 1200.0 * fabs(actual - expected);
+        if (cents > worst_cents) worst_cents = cents;
+    }
+    printf("  Max error: %.4f cents\n", worst_cents);
+    TEST_ASSERT(worst_cents < LOG2_Q16_MAX_CENTS, "fast_log2_q16 should be within its error bound");
+    
+    TEST_ASSERT(fast_log2_q16(65536u) == 0, "log2(1.0) should be exactly 0");
+    TEST_ASSERT(fast_log2_q16(1u) == -(16 << 16), "log2 of 1 LSB should be -16");
+    TEST_ASSERT_FLOAT_EQUAL((float)log2(440.0), (float)fast_log2_q16(440u << 16) / 65536.0f,
+                           0.0001f, "log2(440) should match libm");
+    
+    TEST_PASS("fast_log2_q16 accuracy");
+}
+
+// ============================================================
+// FAST MATH TEST SUITE RUNNER
+// ============================================================
+
+void run_fastmath_tests(int* total, int* passed, int* failed) {
+    print_test_header("FAST MATH TEST SUITE");
+    
+    int tests_passed = 0;
+    int tests_failed = 0;
+    int total_tests = 0;
+    
+    // Run all tests
+    RUN_TEST(test_fast_exp2f_accuracy);
+    RUN_TEST(test_fast_log2f_accuracy);
+    RUN_TEST(test_fast_exp2_q16_accuracy);
+    RUN_TEST(test_fast_log2_q16_accuracy);
+    
+    // Update totals
+    *total += total_tests;
+    *passed += tests_passed;
+    *failed += tests_failed;
+    
+    printf("\nFast Math Suite: %d/%d tests passed\n", 
+           tests_passed, total_tests);
+}
@@ -0,0 +1,146 @@
+// test_freq_counter.c
+// Test bench for the non-blocking frequency counter, on the
+// register-level FC0 mock
+
+#include <stdio.h>
+#include <math.h>
+#include "../include/freq_counter.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+
+// ============================================================
+// FC0 MOCK
+// ============================================================
+
+#define MOCK_SRC 5                 // Any clock source number
+#define MOCK_NO_WRITE 0xFFFFFFFFu  // src value meaning "not written since"
+
+// The test plays the hardware: a write to src starts a measurement
+static bool mock_started(fc_hw_t* fc) {
+    if (fc->src == MOCK_NO_WRITE) {
+        return false;
+    }
+    fc->src = MOCK_NO_WRITE;
+    fc->status = CLOCKS_FC0_STATUS_RUNNING_BITS;
+    return true;
+}
+
+// ... and finishes it with the measured frequency
+static void mock_finish(fc_hw_t* fc, float frequency_hz) {
+    fc->result = (uint32_t)(frequency_hz / 1000.0f * 32.0f + 0.5f);
+    fc->status = CLOCKS_FC0_STATUS_DONE_BITS;
+}
+
+static void mock_reset(fc_hw_t* fc) {
+    fc->src = MOCK_NO_WRITE;
+    fc->status = 0;
+    fc->result = 0;
+}
+
+static int callback_count;
+static float callback_frequency;
+
+static void record_result(float frequency_hz, void* user_data) {
+    (void)user_data;
+    callback_count++;
+    callback_frequency = frequency_hz;
+}
+
+// ============================================================
+// FREQUENCY COUNTER UNIT TESTS
+// ============================================================
+
+// Test 1: Polls never wait, and results arrive when the hardware is done
+bool test_freq_counter_non_blocking(void) {
+    printf("  Testing non-blocking frequency measurement...\n");
+    
+    fc_hw_t fc;
+    mock_reset(&fc);
+    FreqCounter counter;
+    freq_counter_init(&counter, &fc, MOCK_SRC, 12000);
+    
+    // First poll starts a measurement with the configured registers
+    TEST_ASSERT(!freq_counter_poll(&counter), "Start should not give a result");
+    TEST_ASSERT_EQUAL(MOCK_SRC, fc.src, "Source should be written to start");
+    TEST_ASSERT_EQUAL(12000, fc.ref_khz, "Reference should be written");
+    TEST_ASSERT_EQUAL(FREQ_COUNTER_MAX_INTERVAL, fc.interval, "Should start at the finest interval");
+    TEST_ASSERT(mock_started(&fc), "Measurement should be started");
+    
+    // Still running: polls return at once with nothing new
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT(!freq_counter_poll(&counter), "Running measurement should give nothing");
+    }
+    TEST_ASSERT_FLOAT_EQUAL(0.0f, freq_counter_latest(&counter), 0.0f, "No result yet");
+    
+    // Done: the result is published and the next measurement started
+    mock_finish(&fc, 440000.0f);
+    TEST_ASSERT(freq_counter_poll(&counter), "Finished measurement should be published");
+    TEST_ASSERT_FLOAT_EQUAL(440000.0f, freq_counter_latest(&counter), 31.25f,
+                           "Result should be converted from kHz.5");
+    TEST_ASSERT_EQUAL(1, counter.sequence, "Sequence should count results");
+    TEST_ASSERT(mock_started(&fc), "Next measurement should start right away");
+    
+    TEST_PASS("Frequency counter non-blocking");
+}
+
+// Test 2: Callback, and the interval adapts to how fast the pitch moves
+bool test_freq_counter_adaptive_interval(void) {
+    printf("  Testing adaptive measurement interval...\n");
+    
+    fc_hw_t fc;
+    mock_reset(&fc);
+    FreqCounter counter;
+    freq_counter_init(&counter, &fc, MOCK_SRC, 12000);
+    freq_counter_set_callback(&counter, record_result, NULL);
+    callback_count = 0;
+    
+    freq_counter_poll(&counter);
+    mock_started(&fc);
+    
+    // Sliding pitch: 50 cents per measurement → shorter intervals
+    float frequency = 400000.0f;
+    for (int i = 0; i < 10; i++) {
+        mock_finish(&fc, frequency);
+        freq_counter_poll(&counter);
+        mock_started(&fc);
+        frequency *= exp2f(50.0f / 1200.0f);
+    }
+    TEST_ASSERT_EQUAL(10, callback_count, "Callback should see every result");
+    TEST_ASSERT_FLOAT_EQUAL(frequency / exp2f(50.0f / 1200.0f), callback_frequency, 40.0f,
+                           "Callback should get the latest frequency");
+    TEST_ASSERT_EQUAL(FREQ_COUNTER_MIN_INTERVAL, fc.interval, "Fast pitch should shorten the interval");
+    
+    // Held note → back to the finest interval
+    for (int i = 0; i < 10; i++) {
+        mock_finish(&fc, frequency);
+        freq_counter_poll(&counter);
+        mock_started(&fc);
+    }
+    TEST_ASSERT_EQUAL(FREQ_COUNTER_MAX_INTERVAL, fc.interval, "Steady pitch should lengthen the interval");
+    
+    TEST_PASS("Frequency counter adaptive interval");
+}
+
+// ============================================================
+// FREQUENCY COUNTER TEST SUITE RUNNER
+// ============================================================
+
+void run_freq_counter_tests(int* total, int* passed, int* failed) {
+    print_test_header("FREQUENCY COUNTER TEST SUITE");
+    
+    int tests_passed = 0;
+    int tests_failed = 0;
+    int total_tests = 0;
+    
+    // Run all tests
+    RUN_TEST(test_freq_counter_non_blocking);
+    RUN_TEST(test_freq_counter_adaptive_interval);
+    
+    // Update totals
+    *total += total_tests;
+    *passed += tests_passed;
+    *failed += tests_failed;
+    
+    printf("\nFrequency Counter Suite: %d/%d tests passed\n", 
+           tests_passed, total_tests);
+}
@@ -0,0 +1,254 @@
+// test_noise_shaper.c
+// Test bench for the noise-shaping requantizer, with an SNR/THD harness
+// (tones on exact DFT bins, so no window is needed and every bin is
+// either signal, harmonic or noise)
+
+#include <stdio.h>
+#include <math.h>
+#include "../include/noise_shaper.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define TEST_RATE 20000.0          // PWM stream rate (audio_output.c)
+#define TEST_TOP 2047              // PWM_TOP: 11-bit levels
+#define TEST_LENGTH 8192           // DFT length (2.44 Hz bins)
+#define TEST_TONE_BIN 181          // 441.9 Hz
+#define TEST_BAND_HZ 2000.0        // Band the noise is measured in
+#define TEST_HARMONICS 9           // Highest harmonic counted in THD
+
+static const char* order_names[] = { "NONE", "FIRST", "SECOND", "THIRD" };
+
+static int16_t test_input[TEST_LENGTH];
+static uint16_t test_output[TEST_LENGTH];
+static double cos_table[TEST_LENGTH];
+static double sin_table[TEST_LENGTH];
+
+// ============================================================
+// SNR / THD HARNESS
+// ============================================================
+
+typedef struct {
+    double snr_db;             // Tone vs everything else in the band (THD+N)
+    double thd_db;             // Harmonics 2..TEST_HARMONICS vs tone
+} ToneMeasurement;
+
+static void init_dft(void) {
+    static bool ready = false;
+    if (ready) {
+        return;
+    }
+    ready = true;
+    for (int n = 0; n < TEST_LENGTH; n++) {
+        cos_table[n] = cos(2.0 * M_PI * n / TEST_LENGTH);
+        sin_table[n] = sin(2.0 * M_PI * n / TEST_LENGTH);
+    }
+}
+
+// Power in DFT bin k of the output levels
+static double bin_power(const double* x, int k) {
+    double re = 0.0, im = 0.0;
+    for (int n = 0; n < TEST_LENGTH; n++) {
+        int index = (int)(((long)k * n) % TEST_LENGTH);
+        re += x[n] * cos_table[index];
+        im -= x[n] * sin_table[index];
+    }
+    return re * re + im * im;
+}
+
+// Requantize a tone at level_dbfs (0 dBFS = ±32767) and measure it
+static ToneMeasurement measure_tone(NoiseShapeOrder order, double level_dbfs) {
+    static double levels[TEST_LENGTH];
+    init_dft();
+    double amplitude = 32767.0 * pow(10.0, level_dbfs / 20.0);
+    for (int n = 0; n < TEST_LENGTH; n++) {
+        test_input[n] = (int16_t)lrint(amplitude * sin(2.0 * M_PI * TEST_TONE_BIN * n / TEST_LENGTH));
+    }
+
+    // Run twice so the measured pass starts with settled error history
+    // (and the tone wraps seamlessly: it is periodic in TEST_LENGTH)
+    NoiseShaper shaper;
+    noise_shaper_init(&shaper, TEST_TOP + 1, order);
+    noise_shaper_process(&shaper, test_input, test_output, TEST_LENGTH);
+    noise_shaper_process(&shaper, test_input, test_output, TEST_LENGTH);
+    for (int n = 0; n < TEST_LENGTH; n++) {
+        levels[n] = (double)test_output[n];
+    }
+
+    int band_bins = (int)(TEST_BAND_HZ / TEST_RATE * TEST_LENGTH);
+    double tone = bin_power(levels, TEST_TONE_BIN);
+    double noise = 0.0;
+    for (int k = 1; k <= band_bins; k++) {       // Bin 0 is the mid-scale offset
+        if (k != TEST_TONE_BIN) {
+            noise += bin_power(levels, k);
+        }
+    }
+    double harmonics = 0.0;
+    for (int h = 2; h <= TEST_HARMONICS; h++) {
+        harmonics += bin_power(levels, h * TEST_TONE_BIN);
+    }
+
+    ToneMeasurement result;
+    result.snr_db = 10.0 * log10(tone / noise);
+    result.thd_db = 10.0 * log10(harmonics / tone + 1e-20);
+    return result;
+}
+
+// ============================================================
+// NOISE SHAPER UNIT TESTS
+// ============================================================
+
+// Test 1: Without shaping, levels are exactly the old truncation
+bool test_noise_shaper_none_truncates(void) {
+    printf("  Testing unshaped requantization...\n");
+
+    NoiseShaper shaper;
+    noise_shaper_init(&shaper, TEST_TOP + 1, NOISE_SHAPE_NONE);
+    for (int n = 0; n < TEST_LENGTH; n++) {
+        test_input[n] = (int16_t)((n * 97) % 65536 - 32768);
+    }
+    noise_shaper_process(&shaper, test_input, test_output, TEST_LENGTH);
+
+    for (int n = 0; n < TEST_LENGTH; n++) {
+        uint16_t expected = (uint16_t)(((uint32_t)((int32_t)test_input[n] + 32768) * (TEST_TOP + 1)) >> 16);
+        TEST_ASSERT_EQUAL(expected, test_output[n], "NONE should truncate as the PWM always did");
+    }
+
+    TEST_PASS("Unshaped requantization");
+}
+
+// Test 2: The shaped output averages to the exact level, between steps
+bool test_noise_shaper_dc_average(void) {
+    printf("  Testing shaped DC averages...\n");
+
+    for (int order = NOISE_SHAPE_FIRST; order <= NOISE_SHAPE_THIRD; order++) {
+        // A level a third of the way between two PWM steps
+        int16_t sample = (int16_t)(1000 * 32 + 11);
+        double wanted = ((double)sample + 32768.0) * (TEST_TOP + 1) / 65536.0;
+
+        NoiseShaper shaper;
+        noise_shaper_init(&shaper, TEST_TOP + 1, (NoiseShapeOrder)order);
+        for (int n = 0; n < TEST_LENGTH; n++) {
+            test_input[n] = sample;
+        }
+        noise_shaper_process(&shaper, test_input, test_output, TEST_LENGTH);
+
+        double sum = 0.0;
+        for (int n = 0; n < TEST_LENGTH; n++) {
+            sum += test_output[n];
+        }
+        TEST_ASSERT(fabs(sum / TEST_LENGTH - wanted) < 0.01, "Average should hit the level between steps");
+    }
+
+    TEST_PASS("Shaped DC averages");
+}
+
+// Test 3: SNR/THD harness - each order moves more noise out of the band
+bool test_noise_shaper_snr_thd(void) {
+    printf("  Testing in-band SNR / THD (%.0f Hz tone, noise below %.0f Hz)...\n",
+           TEST_TONE_BIN * TEST_RATE / TEST_LENGTH, TEST_BAND_HZ);
+
+    static const double tone_levels[] = { -6.0, -40.0 };
+    for (int t = 0; t < 2; t++) {
+        double previous_snr = -1000.0;
+        double unshaped_thd = 0.0;
+        for (int order = NOISE_SHAPE_NONE; order <= NOISE_SHAPE_THIRD; order++) {
+            ToneMeasurement m = measure_tone((NoiseShapeOrder)order, tone_levels[t]);
+            printf("    %4.0f dBFS  %-6s  SNR %5.1f dB  THD %6.1f dB\n",
+                   tone_levels[t], order_names[order], m.snr_db, m.thd_db);
+
+            TEST_ASSERT(m.snr_db > previous_snr + 4.0, "Each order should gain in-band SNR");
+            previous_snr = m.snr_db;
+            if (order == NOISE_SHAPE_NONE) {
+                unshaped_thd = m.thd_db;
+            } else if (tone_levels[t] < -20.0) {
+                // Loud tones already make the truncation error noise-like
+                TEST_ASSERT(m.thd_db < unshaped_thd - 10.0, "Shaping should break up truncation harmonics");
+            }
+        }
+    }
+
+    TEST_PASS("In-band SNR / THD");
+}
+
+// Test 4: Near full scale, the clamped loop stays stable
+bool test_noise_shaper_full_scale(void) {
+    printf("  Testing shaping stability near full scale...\n");
+
+    for (int order = NOISE_SHAPE_FIRST; order <= NOISE_SHAPE_THIRD; order++) {
+        ToneMeasurement m = measure_tone((NoiseShapeOrder)order, -0.2);
+        printf("    %-6s  SNR %5.1f dB\n", order_names[order], m.snr_db);
+        TEST_ASSERT(m.snr_db > 50.0, "Loop should not run away at full scale");
+    }
+
+    TEST_PASS("Shaping stability near full scale");
+}
+
+// Test 5: Full-scale samples reach the top and bottom levels at the
+// largest level count, and past it (where shaping gives way to
+// truncation instead of overflowing the 16.16 arithmetic)
+bool test_noise_shaper_max_levels(void) {
+    printf("  Testing full scale at the maximum level count...\n");
+
+    static const uint32_t level_counts[] = { NOISE_SHAPER_MAX_LEVELS, 65536 };
+    int16_t high[64];
+    int16_t low[64];
+    uint16_t out[64];
+    for (int i = 0; i < 64; i++) {
+        high[i] = 32767;
+        low[i] = -32768;
+    }
+
+    for (size_t c = 0; c < sizeof(level_counts) / sizeof(level_counts[0]); c++) {
+        uint32_t top = level_counts[c] - 1;
+        for (int order = NOISE_SHAPE_NONE; order <= NOISE_SHAPE_THIRD; order++) {
+            NoiseShaper shaper;
+            noise_shaper_init(&shaper, level_counts[c], (NoiseShapeOrder)order);
+
+            noise_shaper_process(&shaper, high, out, 64);
+            for (int i = 0; i < 64; i++) {
+                TEST_ASSERT(out[i] + 1u >= top, "Full-scale positive should stay at the top level");
+            }
+
+            // (fresh history: the step down from full scale would
+            // otherwise carry the error built up at the top)
+            noise_shaper_set_order(&shaper, (NoiseShapeOrder)order);
+            noise_shaper_process(&shaper, low, out, 64);
+            for (int i = 0; i < 64; i++) {
+                TEST_ASSERT(out[i] <= 1u, "Full-scale negative should stay at the bottom level");
+            }
+        }
+    }
+
+    TEST_PASS("Full scale at the maximum level count");
+}
+
+// ============================================================
+// NOISE SHAPER TEST SUITE RUNNER
+// ============================================================
+
+void run_noise_shaper_tests(int* total, int* passed, int* failed) {
+    print_test_header("NOISE SHAPER TEST SUITE");
+
+    int tests_passed = 0;
+    int tests_failed = 0;
+    int total_tests = 0;
+
+    // Run all tests
+    RUN_TEST(test_noise_shaper_none_truncates);
+    RUN_TEST(test_noise_shaper_dc_average);
+    RUN_TEST(test_noise_shaper_snr_thd);
+    RUN_TEST(test_noise_shaper_full_scale);
+    RUN_TEST(test_noise_shaper_max_levels);
+
+    // Update totals
+    *total += total_tests;
+    *passed += tests_passed;
+    *failed += tests_failed;
+
+    printf("\nNoise Shaper Suite: %d/%d tests passed\n",
+           tests_passed, total_tests);
+}
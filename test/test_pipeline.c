@@ -0,0 +1,311 @@
+// test_pipeline.c
+// Test bench for the dual-core pipeline, with the control core as a
+// pthread (link with -lpthread)
+// The load test runs both halves of sound_profiles.c's split - control
+// points through auto-tune on "core 1", block rendering on "core 0" -
+// and reports how long each takes per block.
+
+#include <stdio.h>
+#include <time.h>
+#include "../include/pipeline.h"
+#include "../include/control.h"
+#include "../include/audio_ring.h"
+#include "../include/autotune.h"
+#include "../include/waveform.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define LOAD_BLOCKS 2000           // Audio blocks rendered in the load test
+#define LOAD_POINTS_PER_BLOCK 8    // Control points per block (as sound_profiles.c)
+#define LOAD_CONTROL_RATE (44100.0f / 32.0f)
+
+// Snapshot k: every field derived from k, so a torn read shows up as
+// fields that don't agree with each other
+static AudioParams make_params(uint32_t k) {
+    AudioParams params;
+    params.profile = (uint8_t)(k & 3);
+    params.waveform = (WaveformType)(k % 4);
+    params.interpolation = (k & 4) ? INTERP_HERMITE : INTERP_LINEAR;
+    params.gain = (q15_t)(1000 * (params.profile + 1) + (int)params.waveform
+                          + ((params.interpolation == INTERP_HERMITE) ? 100 : 0));
+    return params;
+}
+
+static bool params_consistent(const AudioParams* params) {
+    return params->gain == (q15_t)(1000 * (params->profile + 1) + (int)params->waveform
+                                   + ((params->interpolation == INTERP_HERMITE) ? 100 : 0));
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+// ============================================================
+// PIPELINE UNIT TESTS
+// ============================================================
+
+// Test 1: The reader sees the newest whole snapshot, and keeps it
+bool test_pipeline_snapshots(void) {
+    printf("  Testing parameter snapshots...\n");
+
+    ParamSnapshots snapshots;
+    AudioParams initial = make_params(0);
+    snapshot_init(&snapshots, &initial);
+
+    const AudioParams* params = snapshot_latest(&snapshots);
+    TEST_ASSERT_EQUAL(initial.gain, params->gain, "Starts with the initial parameters");
+
+    // Several publishes between reads: only the newest matters
+    for (uint32_t k = 1; k <= 5; k++) {
+        AudioParams next = make_params(k);
+        snapshot_publish(&snapshots, &next);
+    }
+    params = snapshot_latest(&snapshots);
+    TEST_ASSERT_EQUAL(make_params(5).gain, params->gain, "Reader gets the newest snapshot");
+
+    // Nothing new: same slot, same values
+    const AudioParams* again = snapshot_latest(&snapshots);
+    TEST_ASSERT(again == params, "No publish, no swap");
+
+    // The writer keeps going without disturbing the reader's slot
+    for (uint32_t k = 6; k <= 20; k++) {
+        AudioParams next = make_params(k);
+        snapshot_publish(&snapshots, &next);
+        TEST_ASSERT_EQUAL(make_params(5).gain, params->gain, "Reader's slot is never written");
+    }
+    TEST_ASSERT_EQUAL(make_params(20).gain, snapshot_latest(&snapshots)->gain,
+                      "Then it gets the newest again");
+
+    TEST_PASS("Parameter snapshots");
+}
+
+// Inter-core FIFO test: core 1 fills its FIFO, then echoes
+static bool fifo_push_results[PIPELINE_FIFO_DEPTH + 1];
+static uint32_t fifo_core_num;
+
+static void fifo_test_core1(void) {
+    fifo_core_num = pipeline_core_num();
+
+    // Fill the FIFO to the audio core (one more than it holds)
+    for (int i = 0; i <= PIPELINE_FIFO_DEPTH; i++) {
+        fifo_push_results[i] = pipeline_fifo_push(PIPELINE_MSG(PIPELINE_MSG_READY, i));
+    }
+
+    // Echo each BLOCK message back with its payload + 1, until payload 0
+    while (true) {
+        uint32_t message = pipeline_fifo_pop_blocking();
+        uint32_t payload = PIPELINE_MSG_PAYLOAD(message);
+        if (payload == 0) {
+            return;
+        }
+        pipeline_fifo_push_blocking(PIPELINE_MSG(PIPELINE_MSG_BLOCK, payload + 1));
+    }
+}
+
+// Test 2: FIFO depth, order, and both directions
+bool test_pipeline_fifo(void) {
+    printf("  Testing inter-core FIFO...\n");
+
+    TEST_ASSERT_EQUAL(PIPELINE_AUDIO_CORE, pipeline_core_num(), "Test runs on the audio core");
+    pipeline_launch_control_core(fifo_test_core1);
+
+    // The first PIPELINE_FIFO_DEPTH words arrive in order
+    for (uint32_t i = 0; i < PIPELINE_FIFO_DEPTH; i++) {
+        uint32_t message = pipeline_fifo_pop_blocking();
+        TEST_ASSERT_EQUAL(PIPELINE_MSG_READY, PIPELINE_MSG_TYPE(message), "Message type");
+        TEST_ASSERT_EQUAL(i, PIPELINE_MSG_PAYLOAD(message), "Messages in order");
+    }
+
+    // Round trips
+    for (uint32_t i = 1; i < 100; i++) {
+        pipeline_fifo_push_blocking(PIPELINE_MSG(PIPELINE_MSG_BLOCK, i));
+        uint32_t reply = pipeline_fifo_pop_blocking();
+        TEST_ASSERT_EQUAL(i + 1, PIPELINE_MSG_PAYLOAD(reply), "Echo from the control core");
+    }
+    pipeline_fifo_push_blocking(PIPELINE_MSG(PIPELINE_MSG_BLOCK, 0));
+    pipeline_join_control_core();
+
+    TEST_ASSERT_EQUAL(PIPELINE_CONTROL_CORE, fifo_core_num, "Entry ran on the control core");
+    for (int i = 0; i < PIPELINE_FIFO_DEPTH; i++) {
+        TEST_ASSERT(fifo_push_results[i], "Pushes fit in the FIFO");
+    }
+    TEST_ASSERT(!fifo_push_results[PIPELINE_FIFO_DEPTH], "Push to a full FIFO fails");
+
+    TEST_PASS("Inter-core FIFO");
+}
+
+// ============================================================
+// TWO-CORE LOAD TEST
+// ============================================================
+
+static ControlRing load_ring;
+static ParamSnapshots load_snapshots;
+static AutoTuneState load_voice;
+static bool load_done;            // Set by core 0 to stop core 1
+static uint32_t load_points;
+static uint32_t load_block_messages;
+static uint32_t load_max_render_us;
+static double load_control_us;
+
+static void load_wait(void) {
+    struct timespec pause = { 0, 1000 };
+    nanosleep(&pause, NULL);
+}
+
+// Core 1: hand sweep → auto-tune → control ring; a UI that changes the
+// parameters now and then; block stats from core 0
+static void load_control_core(void) {
+    pipeline_fifo_push_blocking(PIPELINE_MSG(PIPELINE_MSG_READY, 0));
+
+    uint32_t k = 0;
+    while (!__atomic_load_n(&load_done, __ATOMIC_ACQUIRE)) {
+        // A slow sweep with vibrato, like a hand moving toward the antenna
+        double start = now_us();
+        float raw = 200.0f + 0.05f * (float)(load_points % 8000)
+                  + 3.0f * (float)((load_points / 40) % 2);
+        ControlPoint point;
+        process_autotune_block(&load_voice, &raw, &point.frequency, 1);
+        point.volume = 1.0f;
+        load_control_us += now_us() - start;
+        load_points++;
+
+        // Wait for room: the ring bounds how far core 1 runs ahead
+        while (!__atomic_load_n(&load_done, __ATOMIC_ACQUIRE)
+               && !control_ring_push(&load_ring, &point)) {
+            load_wait();
+        }
+
+        if ((load_points % 64) == 0) {
+            AudioParams params = make_params(++k);
+            snapshot_publish(&load_snapshots, &params);
+        }
+
+        uint32_t message;
+        while (pipeline_fifo_pop(&message)) {
+            if (PIPELINE_MSG_TYPE(message) == PIPELINE_MSG_BLOCK) {
+                load_block_messages++;
+                if (PIPELINE_MSG_PAYLOAD(message) > load_max_render_us) {
+                    load_max_render_us = PIPELINE_MSG_PAYLOAD(message);
+                }
+            }
+        }
+    }
+}
+
+// Test 3: Both cores running flat out, with every hand-over checked
+bool test_pipeline_load(void) {
+    printf("  Testing two-core pipeline under load (%d blocks)...\n", LOAD_BLOCKS);
+
+    // Shared state, as sound_profiles.c sets it up before core 1 starts
+    autotune_init();
+    AutoTuneConfig config = AUTOTUNE_DEFAULT_CONFIG;
+    config.rate_hz = LOAD_CONTROL_RATE;
+    autotune_state_init(&load_voice, &config);
+
+    ControlPoint initial = { 440.0f, 1.0f };
+    control_ring_init(&load_ring, initial);
+    AudioParams first = make_params(0);
+    snapshot_init(&load_snapshots, &first);
+    static AudioRing ring;
+    audio_ring_init(&ring);
+
+    Oscillator oscillator;
+    oscillator_init(&oscillator, WAVEFORM_SINE);
+    load_done = false;
+    load_points = 0;
+    load_block_messages = 0;
+    load_max_render_us = 0;
+    load_control_us = 0.0;
+
+    pipeline_launch_control_core(load_control_core);
+    uint32_t ready = pipeline_fifo_pop_blocking();
+    TEST_ASSERT_EQUAL(PIPELINE_MSG_READY, PIPELINE_MSG_TYPE(ready), "Control core says it's ready");
+
+    // Core 0: render blocks into the audio ring; this thread also plays
+    // the output side and drains each block
+    uint32_t torn = 0;
+    uint32_t fresh_points = 0;
+    double render_us = 0.0;
+    for (int block = 0; block < LOAD_BLOCKS; block++) {
+        double start = now_us();
+
+        const AudioParams* params = snapshot_latest(&load_snapshots);
+        if (!params_consistent(params)) {
+            torn++;
+        }
+        oscillator_set_waveform(&oscillator, params->waveform);
+        oscillator_set_interpolation(&oscillator, params->interpolation);
+
+        ControlPoint points[LOAD_POINTS_PER_BLOCK];
+        fresh_points += control_ring_pop(&load_ring, points, LOAD_POINTS_PER_BLOCK);
+
+        int16_t* out = audio_ring_acquire_write(&ring);
+        for (int i = 0; i < LOAD_POINTS_PER_BLOCK; i++) {
+            oscillator_set_frequency(&oscillator, points[i].frequency);
+            oscillator_render_block_q15(&oscillator, &out[i * 32], 32, params->gain);
+        }
+        audio_ring_commit_write(&ring);
+
+        double elapsed = now_us() - start;
+        render_us += elapsed;
+        pipeline_fifo_push(PIPELINE_MSG(PIPELINE_MSG_BLOCK, (uint32_t)elapsed));
+
+        audio_ring_acquire_read(&ring);
+        audio_ring_release_read(&ring);
+
+        // Let core 1 catch up now and then (single-core hosts)
+        if ((block & 3) == 0) {
+            load_wait();
+        }
+    }
+
+    __atomic_store_n(&load_done, true, __ATOMIC_RELEASE);
+    pipeline_join_control_core();
+
+    printf("  Audio core:   %.1f us per block (budget %.0f us)\n",
+           render_us / LOAD_BLOCKS, 1e6 * AUDIO_RING_BLOCK_SIZE / 44100.0);
+    printf("  Control core: %.2f us per control point (%u points)\n",
+           load_control_us / (load_points ? load_points : 1), load_points);
+    printf("  Fresh points: %u of %u, BLOCK messages: %u (max %u us)\n",
+           fresh_points, LOAD_BLOCKS * LOAD_POINTS_PER_BLOCK,
+           load_block_messages, load_max_render_us);
+
+    TEST_ASSERT_EQUAL(0, torn, "No torn parameter snapshots");
+    TEST_ASSERT(fresh_points > 0, "Control points reached the audio core");
+    TEST_ASSERT(load_block_messages > 0, "Block stats reached the control core");
+    TEST_ASSERT(load_block_messages <= LOAD_BLOCKS, "No message invented or repeated");
+    TEST_ASSERT_EQUAL(0, ring.overruns, "Audio ring never overran");
+
+    TEST_PASS("Two-core pipeline under load");
+}
+
+// ============================================================
+// PIPELINE TEST SUITE RUNNER
+// ============================================================
+
+void run_pipeline_tests(int* total, int* passed, int* failed) {
+    print_test_header("PIPELINE TEST SUITE");
+
+    int tests_passed = 0;
+    int tests_failed = 0;
+    int total_tests = 0;
+
+    // Run all tests
+    RUN_TEST(test_pipeline_snapshots);
+    RUN_TEST(test_pipeline_fifo);
+    RUN_TEST(test_pipeline_load);
+
+    // Update totals
+    *total += total_tests;
+    *passed += tests_passed;
+    *failed += tests_failed;
+
+    printf("\nPipeline Suite: %d/%d tests passed\n",
+           tests_passed, total_tests);
+}
@@ -0,0 +1,347 @@
+// test_pwm_stream.c
+// Test bench for the DMA PWM audio output, using the host stand-in
+// (the stand-in records every compare value the DMA would write)
+
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include "../include/pwm_stream.h"
+#include "../include/audio_ring.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define TEST_TOP 2047              // 11-bit levels
+#define TEST_BLOCKS 12
+#define TEST_LENGTH (TEST_BLOCKS * PWM_STREAM_BLOCK_SIZE)
+
+static uint16_t recording[TEST_LENGTH];
+static int16_t block_samples[PWM_STREAM_BLOCK_SIZE];
+
+// The level the stream should turn sample n of the test signal into
+static int16_t ramp_sample(int n) {
+    return (int16_t)((n * 97) % 65536 - 32768);
+}
+
+static uint16_t expected_level(int16_t sample) {
+    return (uint16_t)(((uint32_t)((int32_t)sample + 32768) * (TEST_TOP + 1)) >> 16);
+}
+
+// Fill callback: the ramp, continuing from block to block
+static void fill_ramp(int16_t* samples, size_t count, void* user_data) {
+    int* next = (int*)user_data;
+    for (size_t i = 0; i < count; i++) {
+        samples[i] = ramp_sample((*next)++);
+    }
+}
+
+// Fill callback: play the oldest audio ring block (as sound_profiles.c
+// audio_output_fill() does), silence if there is none
+static void fill_from_ring(int16_t* samples, size_t count, void* user_data) {
+    AudioRing* ring = (AudioRing*)user_data;
+    const int16_t* block = audio_ring_acquire_read(ring);
+    if (block == NULL) {
+        memset(samples, 0, count * sizeof(int16_t));
+        return;
+    }
+    memcpy(samples, block, count * sizeof(int16_t));
+    audio_ring_release_read(ring);
+}
+
+// ============================================================
+// PWM STREAM UNIT TESTS
+// ============================================================
+
+// Test 1: Samples map onto 0..top with silence at mid-scale
+bool test_pwm_stream_levels(void) {
+    printf("  Testing PWM level conversion...\n");
+
+    PwmStream stream;
+    pwm_stream_init(&stream, 37, TEST_TOP, 44100.0f);
+
+    block_samples[0] = -32768;
+    block_samples[1] = 0;
+    block_samples[2] = 32767;
+    for (int i = 3; i < PWM_STREAM_BLOCK_SIZE; i++) {
+        block_samples[i] = 0;
+    }
+    TEST_ASSERT(pwm_stream_write_block(&stream, block_samples), "First block should be writable");
+
+    TEST_ASSERT_EQUAL(0, stream.blocks[0][0], "Full negative → 0");
+    TEST_ASSERT_EQUAL((TEST_TOP + 1) / 2, stream.blocks[0][1], "Silence → mid-scale");
+    TEST_ASSERT_EQUAL(TEST_TOP, stream.blocks[0][2], "Full positive → top");
+    TEST_ASSERT_EQUAL((TEST_TOP + 1) / 2, stream.blocks[1][0], "Unwritten block is silence");
+
+    TEST_PASS("PWM level conversion");
+}
+
+// Test 2: With noise shaping, a level between two steps is reached on
+// average (the shaper's state carries from block to block)
+bool test_pwm_stream_noise_shaping(void) {
+    printf("  Testing noise-shaped levels...\n");
+
+    PwmStream stream;
+    pwm_stream_init(&stream, 37, TEST_TOP, 44100.0f);
+    pwm_stream_set_noise_shaping(&stream, NOISE_SHAPE_SECOND);
+
+    // A quarter of the way from mid-scale to the next level
+    for (int i = 0; i < PWM_STREAM_BLOCK_SIZE; i++) {
+        block_samples[i] = 8;
+    }
+    TEST_ASSERT(pwm_stream_write_block(&stream, block_samples), "First block should be writable");
+    TEST_ASSERT(pwm_stream_write_block(&stream, block_samples), "Second block should be writable");
+
+    uint32_t sum = 0;
+    for (int b = 0; b < PWM_STREAM_BLOCKS; b++) {
+        for (int i = 0; i < PWM_STREAM_BLOCK_SIZE; i++) {
+            sum += stream.blocks[b][i];
+        }
+    }
+    float average = (float)sum / (float)(PWM_STREAM_BLOCKS * PWM_STREAM_BLOCK_SIZE);
+    TEST_ASSERT(fabsf(average - ((TEST_TOP + 1) / 2 + 0.25f)) < 0.02f,
+                "Levels should average to the sample between steps");
+
+    TEST_PASS("Noise-shaped levels");
+}
+
+// Test 3: A writer that keeps up gives a gapless stream
+bool test_pwm_stream_gapless_writer(void) {
+    printf("  Testing gapless output (writer)...\n");
+
+    PwmStream stream;
+    pwm_stream_init(&stream, 37, TEST_TOP, 44100.0f);
+    pwm_stream_record(&stream, recording, TEST_LENGTH);
+
+    // Prime both blocks, then start
+    int written = 0;
+    while (pwm_stream_ready(&stream)) {
+        for (int i = 0; i < PWM_STREAM_BLOCK_SIZE; i++) {
+            block_samples[i] = ramp_sample(written * PWM_STREAM_BLOCK_SIZE + i);
+        }
+        pwm_stream_write_block(&stream, block_samples);
+        written++;
+    }
+    TEST_ASSERT_EQUAL(PWM_STREAM_BLOCKS, written, "Both blocks should take samples before start");
+    pwm_stream_start(&stream);
+
+    // The DMA drains in uneven steps; the writer refills whenever a
+    // block is free (like a main loop polling)
+    size_t step = 1;
+    while (stream.recorded < TEST_LENGTH) {
+        pwm_stream_drain(&stream, step);
+        step = (step * 7) % 150 + 1;
+
+        while (pwm_stream_ready(&stream)) {
+            for (int i = 0; i < PWM_STREAM_BLOCK_SIZE; i++) {
+                block_samples[i] = ramp_sample(written * PWM_STREAM_BLOCK_SIZE + i);
+            }
+            pwm_stream_write_block(&stream, block_samples);
+            written++;
+        }
+    }
+
+    for (int n = 0; n < TEST_LENGTH; n++) {
+        TEST_ASSERT_EQUAL(expected_level(ramp_sample(n)), recording[n],
+                          "Every sample should play once, in order");
+    }
+    TEST_ASSERT_EQUAL(0, stream.underruns, "No underruns");
+
+    TEST_PASS("Gapless output (writer)");
+}
+
+// Test 4: The completion-interrupt fill gives a gapless stream
+bool test_pwm_stream_gapless_fill(void) {
+    printf("  Testing gapless output (fill callback)...\n");
+
+    PwmStream stream;
+    int next = 0;
+    pwm_stream_init(&stream, 37, TEST_TOP, 44100.0f);
+    pwm_stream_set_fill(&stream, fill_ramp, &next);
+    pwm_stream_record(&stream, recording, TEST_LENGTH);
+    pwm_stream_start(&stream);
+
+    pwm_stream_drain(&stream, TEST_LENGTH);
+
+    for (int n = 0; n < TEST_LENGTH; n++) {
+        TEST_ASSERT_EQUAL(expected_level(ramp_sample(n)), recording[n],
+                          "Every sample should play once, in order");
+    }
+    TEST_ASSERT_EQUAL(TEST_BLOCKS, stream.blocks_played, "One interrupt per block");
+    TEST_ASSERT_EQUAL(0, stream.underruns, "No underruns");
+
+    TEST_PASS("Gapless output (fill callback)");
+}
+
+// Test 5: A writer that falls behind is counted, and the stream goes on
+bool test_pwm_stream_underrun(void) {
+    printf("  Testing underrun detection...\n");
+
+    PwmStream stream;
+    pwm_stream_init(&stream, 37, TEST_TOP, 44100.0f);
+    pwm_stream_record(&stream, recording, TEST_LENGTH);
+    for (int i = 0; i < PWM_STREAM_BLOCK_SIZE; i++) {
+        block_samples[i] = 1000;
+    }
+    pwm_stream_write_block(&stream, block_samples);
+    pwm_stream_write_block(&stream, block_samples);
+    pwm_stream_start(&stream);
+
+    // Nobody writes: blocks 0 and 1 play, then block 0 replays
+    pwm_stream_drain(&stream, 3 * PWM_STREAM_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(3 * PWM_STREAM_BLOCK_SIZE, stream.recorded, "Output never stops");
+    TEST_ASSERT_EQUAL(2, stream.underruns, "Blocks replayed after the queue ran dry");
+
+    // The writer catches up: its block is next
+    TEST_ASSERT(pwm_stream_ready(&stream), "A block should be free");
+    for (int i = 0; i < PWM_STREAM_BLOCK_SIZE; i++) {
+        block_samples[i] = -1000;
+    }
+    pwm_stream_write_block(&stream, block_samples);
+    pwm_stream_drain(&stream, 2 * PWM_STREAM_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(expected_level(-1000), recording[4 * PWM_STREAM_BLOCK_SIZE],
+                      "New samples play right after the current block");
+
+    TEST_PASS("Underrun detection");
+}
+
+// Test 6: The pacing timer fraction lands close to the audio rates
+bool test_pwm_stream_pacing(void) {
+    printf("  Testing DMA pacing timer fraction...\n");
+
+    const float rates[] = { 44100.0f, 48000.0f, 22050.0f, 20000.0f };
+    for (int i = 0; i < 4; i++) {
+        uint16_t x, y;
+        float actual = pwm_stream_pacing_fraction(150000000u, rates[i], &x, &y);
+        float ppm = 1e6f * (actual - rates[i]) / rates[i];
+        if (ppm < 0.0f) ppm = -ppm;
+        printf("  %.0f Hz: %u/%u → %.3f Hz (%.1f ppm)\n", rates[i], x, y, actual, ppm);
+        TEST_ASSERT(ppm < 10.0f, "Rate should be within 10 ppm");
+        TEST_ASSERT(x <= y, "Numerator can't exceed denominator");
+    }
+
+    TEST_PASS("DMA pacing timer fraction");
+}
+
+// Test 7: The stream consumes the audio ring: a producer that waits
+// for ring space is paced by the output and never stalls for good
+bool test_pwm_stream_ring_consumer(void) {
+    printf("  Testing the audio ring drained by the stream...\n");
+
+    static AudioRing ring;
+    audio_ring_init(&ring);
+
+    PwmStream stream;
+    pwm_stream_init(&stream, 37, TEST_TOP, 44100.0f);
+    pwm_stream_set_fill(&stream, fill_from_ring, &ring);
+    pwm_stream_record(&stream, recording, TEST_LENGTH);
+
+    // The sound_profiles.c main loop: render whenever there is space,
+    // start the output once the ring is full; in between, the "DMA"
+    // plays one block (the real loop spins until the interrupt frees one).
+    // The stream refills a block as soon as it drains, so it asks for
+    // PWM_STREAM_BLOCKS more than it records.
+    const int rendered = TEST_LENGTH + PWM_STREAM_BLOCKS * PWM_STREAM_BLOCK_SIZE;
+    int next = 0;
+    bool started = false;
+    while (stream.recorded < TEST_LENGTH) {
+        while (audio_ring_space(&ring) > 0 && next < rendered) {
+            int16_t* block = audio_ring_acquire_write(&ring);
+            fill_ramp(block, AUDIO_RING_BLOCK_SIZE, &next);
+            audio_ring_commit_write(&ring);
+        }
+        if (!started) {
+            pwm_stream_start(&stream);
+            started = true;
+        }
+        pwm_stream_drain(&stream, PWM_STREAM_BLOCK_SIZE);
+        TEST_ASSERT(audio_ring_space(&ring) > 0, "Each block played should free a ring block");
+    }
+
+    for (int n = 0; n < TEST_LENGTH; n++) {
+        TEST_ASSERT_EQUAL(expected_level(ramp_sample(n)), recording[n],
+                          "Every rendered sample should play once, in order");
+    }
+    TEST_ASSERT_EQUAL(0, ring.underruns, "Ring should never run dry");
+    TEST_ASSERT_EQUAL(0, ring.overruns, "Producer should never overrun");
+
+    TEST_PASS("Audio ring drained by the stream");
+}
+
+// Test 8: Two streams keep their own buffers and fill scratch
+bool test_pwm_stream_independent(void) {
+    printf("  Testing two DMA streams side by side...\n");
+
+    static PwmStream left;
+    static PwmStream right;
+    static uint16_t right_recording[TEST_LENGTH];
+    int left_next = 0;
+    int right_next = 0;
+    pwm_stream_init(&left, 37, TEST_TOP, 44100.0f);
+    pwm_stream_init(&right, 38, TEST_TOP, 44100.0f);
+
+    // Each gets its own buffer, aligned for the DMA read ring
+    TEST_ASSERT(left.blocks[0] != right.blocks[0], "Streams should not share a buffer");
+    TEST_ASSERT(((uintptr_t)left.blocks[0] % (PWM_STREAM_BLOCKS * PWM_STREAM_BLOCK_BYTES)) == 0,
+                "Buffer should be aligned for the read ring");
+    TEST_ASSERT(((uintptr_t)right.blocks[0] % (PWM_STREAM_BLOCKS * PWM_STREAM_BLOCK_BYTES)) == 0,
+                "Buffer should be aligned for the read ring");
+
+    // Both fill from the ramp, one a block ahead; interleaved drains
+    // mean each fill runs between the other stream's fills
+    right_next = PWM_STREAM_BLOCK_SIZE;
+    pwm_stream_set_fill(&left, fill_ramp, &left_next);
+    pwm_stream_set_fill(&right, fill_ramp, &right_next);
+    pwm_stream_record(&left, recording, TEST_LENGTH);
+    pwm_stream_record(&right, right_recording, TEST_LENGTH - PWM_STREAM_BLOCK_SIZE);
+    pwm_stream_start(&left);
+    pwm_stream_start(&right);
+
+    for (int n = 0; n < TEST_LENGTH; n += 100) {
+        size_t count = (TEST_LENGTH - n < 100) ? (size_t)(TEST_LENGTH - n) : 100;
+        pwm_stream_drain(&left, count);
+        pwm_stream_drain(&right, count);
+    }
+
+    for (int n = 0; n < TEST_LENGTH - PWM_STREAM_BLOCK_SIZE; n++) {
+        TEST_ASSERT_EQUAL(expected_level(ramp_sample(n)), recording[n],
+                          "Left stream should play its own samples");
+        TEST_ASSERT_EQUAL(expected_level(ramp_sample(n + PWM_STREAM_BLOCK_SIZE)), right_recording[n],
+                          "Right stream should play its own samples");
+    }
+    TEST_ASSERT_EQUAL(0, left.underruns + right.underruns, "No underruns");
+
+    TEST_PASS("Independent DMA streams");
+}
+
+// ============================================================
+// PWM STREAM TEST SUITE RUNNER
+// ============================================================
+
+void run_pwm_stream_tests(int* total, int* passed, int* failed) {
+    print_test_header("PWM STREAM TEST SUITE");
+
+    int tests_passed = 0;
+    int tests_failed = 0;
+    int total_tests = 0;
+
+    // Run all tests
+    RUN_TEST(test_pwm_stream_levels);
+    RUN_TEST(test_pwm_stream_noise_shaping);
+    RUN_TEST(test_pwm_stream_gapless_writer);
+    RUN_TEST(test_pwm_stream_gapless_fill);
+    RUN_TEST(test_pwm_stream_underrun);
+    RUN_TEST(test_pwm_stream_pacing);
+    RUN_TEST(test_pwm_stream_ring_consumer);
+    RUN_TEST(test_pwm_stream_independent);
+
+    // Update totals
+    *total += total_tests;
+    *passed += tests_passed;
+    *failed += tests_failed;
+
+    printf("\nPWM Stream Suite: %d/%d tests passed\n",
+           tests_passed, total_tests);
+}
@@ -0,0 +1,187 @@
+// test_resampler.c
+// Test bench for the polyphase sample-rate converter
+
+#include <stdio.h>
+#include <math.h>
+#include "../include/resampler.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define SYNTH_RATE 44100.0f        // Oscillator rate (SAMPLE_RATE)
+#define PWM_RATE 20000.0f          // PWM stream rate (audio_output.c)
+#define TEST_INPUTS 8192
+#define TEST_BLOCK 256             // AUDIO_BUFFER_SIZE
+#define TEST_SETTLE 64             // Outputs skipped while the filter fills
+#define TEST_AMPLITUDE 16384.0f    // Half scale
+
+static const char* quality_names[] = { "FAST", "MEDIUM", "HIGH" };
+
+// Minimum SNR of a 1 kHz tone, and alias rejection of a 14 kHz tone
+// (folds to 6 kHz at 20 kHz), per preset (the Q15 coefficients put a
+// floor near 73 dB under both)
+static const float min_snr_db[] = { 45.0f, 65.0f, 65.0f };
+static const float min_rejection_db[] = { 45.0f, 65.0f, 65.0f };
+
+static int16_t test_input[TEST_INPUTS];
+static int16_t test_output[TEST_INPUTS * 3];
+
+static void make_tone(float frequency, float rate) {
+    for (int i = 0; i < TEST_INPUTS; i++) {
+        test_input[i] = (int16_t)lrintf(TEST_AMPLITUDE * sinf(2.0f * (float)M_PI * frequency * (float)i / rate));
+    }
+}
+
+// Run test_input through in TEST_BLOCK pieces, as the audio loop would
+static size_t convert(Resampler* resampler) {
+    size_t count = 0;
+    for (int i = 0; i < TEST_INPUTS; i += TEST_BLOCK) {
+        count += resampler_process(resampler, &test_input[i], TEST_BLOCK,
+                                   &test_output[count], sizeof(test_output) / sizeof(test_output[0]) - count);
+    }
+    return count;
+}
+
+// SNR (dB) of a converted tone against the ideal tone at the output rate
+// (output k is the input at time k / output_rate, no delay to correct)
+static float tone_snr_db(ResamplerQuality quality, float in_rate, float out_rate, float frequency) {
+    static Resampler resampler;
+    resampler_init(&resampler, in_rate, out_rate, quality);
+    make_tone(frequency, in_rate);
+    size_t count = convert(&resampler);
+
+    double signal = 0.0, error = 0.0;
+    for (size_t k = TEST_SETTLE; k < count; k++) {
+        double ideal = TEST_AMPLITUDE * sin(2.0 * M_PI * frequency * (double)k / out_rate);
+        signal += ideal * ideal;
+        error += (test_output[k] - ideal) * (test_output[k] - ideal);
+    }
+    return (float)(10.0 * log10(signal / error));
+}
+
+// ============================================================
+// RESAMPLER UNIT TESTS
+// ============================================================
+
+// Test 1: DC passes exactly, and the output count follows the ratio
+bool test_resampler_dc_gain(void) {
+    printf("  Testing resampler DC gain and output count...\n");
+
+    static Resampler resampler;
+    for (int q = RESAMPLER_FAST; q <= RESAMPLER_HIGH; q++) {
+        resampler_init(&resampler, SYNTH_RATE, PWM_RATE, (ResamplerQuality)q);
+        for (int i = 0; i < TEST_INPUTS; i++) {
+            test_input[i] = -12345;
+        }
+        size_t count = convert(&resampler);
+
+        // Outputs up to (inputs - taps / 2) / ratio are complete
+        float expected = (float)(TEST_INPUTS - resampler.taps / 2) * PWM_RATE / SYNTH_RATE;
+        TEST_ASSERT(fabsf((float)count - expected) <= 1.0f, "Output count should follow the ratio");
+        for (size_t k = TEST_SETTLE; k < count; k++) {
+            TEST_ASSERT_EQUAL(-12345, test_output[k], "DC should pass with unity gain");
+        }
+    }
+
+    TEST_PASS("Resampler DC gain and output count");
+}
+
+// Test 2: Block size doesn't matter (history and phase carry across calls)
+bool test_resampler_block_independent(void) {
+    printf("  Testing resampler across uneven blocks...\n");
+
+    static Resampler whole, pieces;
+    static int16_t piece_output[TEST_INPUTS];
+    make_tone(1234.5f, SYNTH_RATE);
+
+    resampler_init(&whole, SYNTH_RATE, PWM_RATE, RESAMPLER_MEDIUM);
+    size_t whole_count = resampler_process(&whole, test_input, TEST_INPUTS, test_output, TEST_INPUTS);
+
+    resampler_init(&pieces, SYNTH_RATE, PWM_RATE, RESAMPLER_MEDIUM);
+    size_t piece_count = 0;
+    size_t position = 0;
+    size_t chunk = 7;
+    while (position < TEST_INPUTS) {
+        size_t n = (TEST_INPUTS - position < chunk) ? TEST_INPUTS - position : chunk;
+        piece_count += resampler_process(&pieces, &test_input[position], n,
+                                         &piece_output[piece_count], TEST_INPUTS - piece_count);
+        position += n;
+        chunk = chunk * 5 % 397 + 1;
+    }
+
+    TEST_ASSERT_EQUAL(whole_count, piece_count, "Same number of outputs");
+    for (size_t k = 0; k < whole_count; k++) {
+        TEST_ASSERT_EQUAL(test_output[k], piece_output[k], "Same outputs whatever the block size");
+    }
+
+    TEST_PASS("Resampler across uneven blocks");
+}
+
+// Test 3: An in-band tone comes through clean, both directions
+bool test_resampler_passband_snr(void) {
+    printf("  Testing resampler passband SNR (1 kHz)...\n");
+
+    for (int q = RESAMPLER_FAST; q <= RESAMPLER_HIGH; q++) {
+        float down = tone_snr_db((ResamplerQuality)q, SYNTH_RATE, PWM_RATE, 1000.0f);
+        float up = tone_snr_db((ResamplerQuality)q, PWM_RATE, SYNTH_RATE, 1000.0f);
+        printf("    %-6s 44.1k→20k: %5.1f dB   20k→44.1k: %5.1f dB\n", quality_names[q], down, up);
+        TEST_ASSERT(down >= min_snr_db[q], "Downsampled tone should meet the preset's SNR");
+        TEST_ASSERT(up >= min_snr_db[q], "Upsampled tone should meet the preset's SNR");
+    }
+
+    TEST_PASS("Resampler passband SNR");
+}
+
+// Test 4: A tone above the output Nyquist is filtered, not folded
+bool test_resampler_aliasing(void) {
+    printf("  Testing resampler alias rejection (14 kHz → 20 kHz rate)...\n");
+
+    static Resampler resampler;
+    for (int q = RESAMPLER_FAST; q <= RESAMPLER_HIGH; q++) {
+        resampler_init(&resampler, SYNTH_RATE, PWM_RATE, (ResamplerQuality)q);
+        make_tone(14000.0f, SYNTH_RATE);
+        size_t count = convert(&resampler);
+
+        double power = 0.0;
+        for (size_t k = TEST_SETTLE; k < count; k++) {
+            power += (double)test_output[k] * test_output[k];
+        }
+        power /= (double)(count - TEST_SETTLE);
+        double input_power = TEST_AMPLITUDE * TEST_AMPLITUDE / 2.0;
+        float rejection = (float)(10.0 * log10(input_power / (power + 1e-3)));
+
+        printf("    %-6s alias at 6 kHz: -%5.1f dB\n", quality_names[q], rejection);
+        TEST_ASSERT(rejection >= min_rejection_db[q], "Alias should be below the preset's stopband");
+    }
+
+    TEST_PASS("Resampler alias rejection");
+}
+
+// ============================================================
+// RESAMPLER TEST SUITE RUNNER
+// ============================================================
+
+void run_resampler_tests(int* total, int* passed, int* failed) {
+    print_test_header("RESAMPLER TEST SUITE");
+
+    int tests_passed = 0;
+    int tests_failed = 0;
+    int total_tests = 0;
+
+    // Run all tests
+    RUN_TEST(test_resampler_dc_gain);
+    RUN_TEST(test_resampler_block_independent);
+    RUN_TEST(test_resampler_passband_snr);
+    RUN_TEST(test_resampler_aliasing);
+
+    // Update totals
+    *total += total_tests;
+    *passed += tests_passed;
+    *failed += tests_failed;
+
+    printf("\nResampler Suite: %d/%d tests passed\n",
+           tests_passed, total_tests);
+}
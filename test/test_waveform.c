@@ -0,0 +1,256 @@
+// test_waveform.c
+// Test bench for the oscillator: block render vs per-sample, table
+// interpolation accuracy, mipmap level choice and the PolyBLEP waveforms
+
+#include <stdio.h>
+#include <math.h>
+#include "../include/waveform.h"
+#include "../include/test_utils.h"
+#include "pico/stdlib.h"
+
+// ============================================================
+// CONFIGURATION
+// ============================================================
+
+#define TEST_BLOCK 256
+#define TEST_WAVEFORMS 7          // WAVEFORM_SINE .. WAVEFORM_TRIANGLE_BLEP
+#define TEST_MODES 3              // INTERP_NONE .. INTERP_HERMITE
+
+// Max error against sinf for a 65 Hz sine (the Q15 tables put the
+// floor at ~1 LSB = 3.1e-5; the commits measured 1.1e-4 / 1.0e-4)
+#define LINEAR_ERROR_BOUND 1.2e-4f
+#define HERMITE_ERROR_BOUND 1.2e-4f
+
+static float block_float[TEST_BLOCK];
+static q15_t block_q15[TEST_BLOCK];
+
+// Pitches from low bass to past the top mipmap edge, so every table
+// level and the BLEP edge cases get used
+static const float test_frequencies[] = { 65.41f, 440.0f, 1230.0f, 3520.0f, 9000.0f };
+#define TEST_FREQUENCIES (sizeof(test_frequencies) / sizeof(test_frequencies[0]))
+
+// ============================================================
+// WAVEFORM UNIT TESTS
+// ============================================================
+
+// Test 1: Block render gives exactly the per-sample output
+bool test_waveform_block_matches_sample(void) {
+    printf("  Testing block render against per-sample generation...\n");
+
+    for (int type = 0; type < TEST_WAVEFORMS; type++) {
+        for (int mode = 0; mode < TEST_MODES; mode++) {
+            for (size_t f = 0; f < TEST_FREQUENCIES; f++) {
+                Oscillator block_osc;
+                Oscillator sample_osc;
+                oscillator_init(&block_osc, (WaveformType)type);
+                oscillator_set_interpolation(&block_osc, (InterpolationMode)mode);
+                oscillator_set_frequency(&block_osc, test_frequencies[f]);
+                block_osc.phase = 0x12345678u;   // Not on a table entry
+                sample_osc = block_osc;
+
+                // Float path
+                oscillator_render_block(&block_osc, block_float, TEST_BLOCK);
+                for (int i = 0; i < TEST_BLOCK; i++) {
+                    float expected = oscillator_generate_sample(&sample_osc);
+                    TEST_ASSERT(fabsf(expected - block_float[i]) <= 1e-6f,
+                                "Float block should match oscillator_generate_sample()");
+                }
+                TEST_ASSERT(block_osc.phase == sample_osc.phase, "Block should advance the phase by n steps");
+
+                // Q15 path at full scale
+                oscillator_render_block_q15(&block_osc, block_q15, TEST_BLOCK, Q15_ONE);
+                for (int i = 0; i < TEST_BLOCK; i++) {
+                    q15_t expected = oscillator_generate_sample_q15(&sample_osc);
+                    TEST_ASSERT_EQUAL(expected, block_q15[i],
+                                      "Q15 block should match oscillator_generate_sample_q15()");
+                }
+                TEST_ASSERT(block_osc.phase == sample_osc.phase, "Q15 block should advance the phase by n steps");
+            }
+        }
+    }
+
+    TEST_PASS("Block render matches per-sample generation");
+}
+
+// Test 2: The Q15 gain scales each full-scale sample by gain / 2^15
+bool test_waveform_q15_gain(void) {
+    printf("  Testing Q15 gain path...\n");
+
+    static const q15_t gains[] = { 0, 1, 8192, 16384, 32766 };
+
+    for (size_t g = 0; g < sizeof(gains) / sizeof(gains[0]); g++) {
+        for (int type = 0; type < TEST_WAVEFORMS; type++) {
+            Oscillator block_osc;
+            Oscillator sample_osc;
+            oscillator_init(&block_osc, (WaveformType)type);
+            oscillator_set_interpolation(&block_osc, INTERP_LINEAR);
+            oscillator_set_frequency(&block_osc, 440.0f);
+            sample_osc = block_osc;
+
+            oscillator_render_block_q15(&block_osc, block_q15, TEST_BLOCK, gains[g]);
+            for (int i = 0; i < TEST_BLOCK; i++) {
+                int32_t full = oscillator_generate_sample_q15(&sample_osc);
+                TEST_ASSERT_EQUAL((full * gains[g]) >> 15, block_q15[i],
+                                  "Gain should scale the full-scale sample");
+            }
+        }
+    }
+
+    TEST_PASS("Q15 gain path");
+}
+
+// Test 3: Linear and Hermite interpolation stay within the claimed
+// error of the true sine, on both the float and the Q15 path
+bool test_waveform_interpolation_error(void) {
+    printf("  Testing interpolation error against sinf...\n");
+
+    static const InterpolationMode modes[] = { INTERP_LINEAR, INTERP_HERMITE };
+    static const float bounds[] = { LINEAR_ERROR_BOUND, HERMITE_ERROR_BOUND };
+    static const char* names[] = { "linear", "hermite" };
+
+    for (int m = 0; m < 2; m++) {
+        Oscillator osc;
+        oscillator_init(&osc, WAVEFORM_SINE);
+        oscillator_set_interpolation(&osc, modes[m]);
+        oscillator_set_frequency(&osc, 65.41f);
+
+        // A few cycles, so every table segment is crossed at many fractions
+        float max_error = 0.0f;
+        float max_error_q15 = 0.0f;
+        for (int i = 0; i < 4 * SAMPLE_RATE / 65; i++) {
+            uint32_t phase = osc.phase;
+            float exact = sinf(6.2831853f * (float)((double)phase / 4294967296.0));
+
+            Oscillator q15_osc = osc;
+            float q15_value = (float)oscillator_generate_sample_q15(&q15_osc) * Q15_TO_FLOAT;
+            float value = oscillator_generate_sample(&osc);
+
+            float error = fabsf(value - exact);
+            float error_q15 = fabsf(q15_value - exact);
+            if (error > max_error) max_error = error;
+            if (error_q15 > max_error_q15) max_error_q15 = error_q15;
+        }
+
+        printf("    %-8s max error %.2e (float), %.2e (Q15)\n", names[m], max_error, max_error_q15);
+        TEST_ASSERT(max_error <= bounds[m], "Float interpolation error should stay within the bound");
+        TEST_ASSERT(max_error_q15 <= bounds[m], "Q15 interpolation error should stay within the bound");
+    }
+
+    TEST_PASS("Interpolation error against sinf");
+}
+
+// Test 4: At every mipmap level edge, the chosen table's top harmonic
+// stays below Nyquist, and each table holds no harmonic above it
+bool test_waveform_mipmap_levels(void) {
+    printf("  Testing mipmap level choice and table content...\n");
+
+    // Level k holds harmonics 1..(128 >> k); harmonic h of a phase
+    // increment is below Nyquist while h × increment < 2^31
+    for (int edge = 0; edge < MIPMAP_LEVELS; edge++) {
+        uint64_t limit = 1ull << (MIPMAP_BASE_SHIFT + edge);
+        uint32_t increments[] = { (uint32_t)(limit - 1), (uint32_t)(limit >> 1) + 1 };
+
+        for (int i = 0; i < 2; i++) {
+            uint32_t increment = increments[i];
+            int level = waveform_mipmap_level(increment);
+            uint64_t top_harmonic = 128u >> level;
+            TEST_ASSERT(level >= 0 && level < MIPMAP_LEVELS, "Level should be a valid table");
+            TEST_ASSERT(top_harmonic * increment < (1ull << 31),
+                        "Top harmonic of the chosen level should be below Nyquist");
+        }
+
+        // One past the edge moves up a level (no level wasted too early)
+        if (edge < MIPMAP_LEVELS - 1) {
+            TEST_ASSERT_EQUAL(edge + 1, waveform_mipmap_level((uint32_t)limit),
+                              "Crossing an edge should go up one level");
+        }
+    }
+    TEST_ASSERT_EQUAL(0, waveform_mipmap_level(1), "Lowest pitch should use all harmonics");
+
+    // Each table: DFT bins above its top harmonic are at the Q15 floor
+    const int16_t (*tables[2])[WAVETABLE_SIZE] = { square_table, sawtooth_table };
+    for (int t = 0; t < 2; t++) {
+        for (int level = 0; level < MIPMAP_LEVELS; level++) {
+            int top_harmonic = 128 >> level;
+            for (int bin = top_harmonic + 1; bin < WAVETABLE_SIZE / 2; bin++) {
+                double re = 0.0;
+                double im = 0.0;
+                for (int n = 0; n < WAVETABLE_SIZE; n++) {
+                    double angle = 6.283185307179586 * bin * n / WAVETABLE_SIZE;
+                    re += tables[t][level][n] * cos(angle);
+                    im -= tables[t][level][n] * sin(angle);
+                }
+                // Amplitude relative to full scale (a unit harmonic = 1.0)
+                double amplitude = 2.0 * sqrt(re * re + im * im) / (WAVETABLE_SIZE * (double)Q15_ONE);
+                TEST_ASSERT(amplitude < 1e-4, "Table should hold no harmonic above its level's limit");
+            }
+        }
+    }
+
+    TEST_PASS("Mipmap level choice and table content");
+}
+
+// Test 5: The BLEP waveforms stay in ±1 and are continuous at the phase
+// wrap (and at the square's half-cycle step)
+bool test_waveform_blep_range_and_wrap(void) {
+    printf("  Testing PolyBLEP range and continuity at the wrap...\n");
+
+    for (int type = WAVEFORM_SQUARE_BLEP; type <= WAVEFORM_TRIANGLE_BLEP; type++) {
+        for (size_t f = 0; f < TEST_FREQUENCIES; f++) {
+            // Range: many cycles at an increment that lands at every
+            // offset from the edges
+            Oscillator osc;
+            oscillator_init(&osc, (WaveformType)type);
+            oscillator_set_frequency(&osc, test_frequencies[f]);
+            for (int block = 0; block < 16; block++) {
+                oscillator_render_block(&osc, block_float, TEST_BLOCK);
+                for (int i = 0; i < TEST_BLOCK; i++) {
+                    TEST_ASSERT(block_float[i] >= -1.0f && block_float[i] <= 1.0f,
+                                "BLEP waveform should stay within ±1");
+                }
+            }
+
+            // Continuity: just before the wrap and just after it (one
+            // phase LSB that survives phase_to_unit() apart) give the
+            // same value
+            static const uint32_t edges[] = { 0u, 0x80000000u };
+            for (int e = 0; e < 2; e++) {
+                Oscillator before = osc;
+                Oscillator after = osc;
+                before.phase = edges[e] - 256u;
+                after.phase = edges[e];
+                float jump = fabsf(oscillator_generate_sample(&after) - oscillator_generate_sample(&before));
+                TEST_ASSERT(jump < 1e-3f, "BLEP waveform should be continuous across its edges");
+            }
+        }
+    }
+
+    TEST_PASS("PolyBLEP range and continuity");
+}
+
+// ============================================================
+// WAVEFORM TEST SUITE RUNNER
+// ============================================================
+
+void run_waveform_tests(int* total, int* passed, int* failed) {
+    print_test_header("WAVEFORM TEST SUITE");
+
+    int tests_passed = 0;
+    int tests_failed = 0;
+    int total_tests = 0;
+
+    // Run all tests
+    RUN_TEST(test_waveform_block_matches_sample);
+    RUN_TEST(test_waveform_q15_gain);
+    RUN_TEST(test_waveform_interpolation_error);
+    RUN_TEST(test_waveform_mipmap_levels);
+    RUN_TEST(test_waveform_blep_range_and_wrap);
+
+    // Update totals
+    *total += total_tests;
+    *passed += tests_passed;
+    *failed += tests_failed;
+
+    printf("\nWaveform Suite: %d/%d tests passed\n",
+           tests_passed, total_tests);
+}
@@ -0,0 +1,147 @@
+# gen_wavetables.py
+# Build-time generator for the Q15 wavetables in src/wavetables.c
+#
+# Runs automatically before every PlatformIO build (extra_scripts in
+# platformio.ini) and can also be run by hand on the host:
+#     python3 tools/gen_wavetables.py
+#
+# The tables are emitted as const arrays, so they live in flash (or in the
+# RAM section chosen with WAVETABLES_IN_RAM) and nothing is computed at
+# boot. Host tests and the device compile the same generated file, so
+# their tables are bit-identical.
+
+import math
+import os
+
+WAVETABLE_SIZE = 256     # must match waveform.h
+MIPMAP_LEVELS = 8        # must match waveform.h
+Q15_ONE = 32767
+
+
+def to_q15(value):
+    # Round half away from zero, saturate to -32767..+32767
+    scaled = value * Q15_ONE
+    scaled = max(-Q15_ONE, min(Q15_ONE, scaled))
+    return int(math.floor(scaled + 0.5)) if scaled >= 0 else -int(math.floor(-scaled + 0.5))
+
+
+def make_sine():
+    return [to_q15(math.sin(2.0 * math.pi * i / WAVETABLE_SIZE))
+            for i in range(WAVETABLE_SIZE)]
+
+
+def make_triangle():
+    # Ramps up -1.0 -> +1.0 over the first half, back down over the second
+    table = []
+    for i in range(WAVETABLE_SIZE):
+        position = i / WAVETABLE_SIZE
+        if i < WAVETABLE_SIZE // 2:
+            table.append(to_q15(position * 4.0 - 1.0))
+        else:
+            table.append(to_q15(3.0 - position * 4.0))
+    return table
+
+
+def make_mipmaps(sine, sawtooth):
+    # Additive synthesis per octave, see MIPMAP_LEVELS in waveform.h:
+    #   square   = sum over odd h of  sin(h x) / h
+    #   sawtooth = sum over all h of -sin(h x) / h
+    # Level k holds harmonics 1..(128 >> k). The partials come from the
+    # Q15 sine table (sin(h x) at entry i is sine[(h * i) % size]).
+    levels = []
+    for level in range(MIPMAP_LEVELS):
+        max_harmonic = (WAVETABLE_SIZE // 2) >> level
+        samples = []
+        for i in range(WAVETABLE_SIZE):
+            total = 0.0
+            for h in range(1, max_harmonic + 1):
+                partial = sine[(h * i) % WAVETABLE_SIZE] / h
+                if sawtooth:
+                    total -= partial
+                elif h & 1:
+                    total += partial
+            samples.append(total)
+        levels.append(samples)
+
+    # One scale factor for ALL levels, so the fundamental keeps its
+    # loudness when the level changes (Gibbs ripple sets the peak)
+    peak = max(abs(x) for samples in levels for x in samples)
+    return [[to_q15(x / peak) for x in samples] for samples in levels]
+
+
+def format_table(values, indent):
+    lines = []
+    for start in range(0, len(values), 12):
+        row = ", ".join("%6d" % v for v in values[start:start + 12])
+        lines.append(indent + row + ",")
+    return "\n".join(lines)
+
+
+def format_levels(levels):
+    blocks = []
+    for level, samples in enumerate(levels):
+        blocks.append("    { // level %d: harmonics 1..%d\n%s\n    },"
+                      % (level, (WAVETABLE_SIZE // 2) >> level,
+                         format_table(samples, "        ")))
+    return "\n".join(blocks)
+
+
+def generate():
+    sine = make_sine()
+    triangle = make_triangle()
+    square = make_mipmaps(sine, sawtooth=False)
+    sawtooth = make_mipmaps(sine, sawtooth=True)
+
+    return """// wavetables.c
+// GENERATED by tools/gen_wavetables.py - do not edit by hand
+// Q15 wavetables (-32767 to +32767), one cycle of %d samples each
+
+#include "../include/waveform.h"
+
+const int16_t sine_table[WAVETABLE_SIZE] WAVETABLE_SECTION = {
+%s
+};
+
+const int16_t triangle_table[WAVETABLE_SIZE] WAVETABLE_SECTION = {
+%s
+};
+
+const int16_t square_table[MIPMAP_LEVELS][WAVETABLE_SIZE] WAVETABLE_SECTION = {
+%s
+};
+
+const int16_t sawtooth_table[MIPMAP_LEVELS][WAVETABLE_SIZE] WAVETABLE_SECTION = {
+%s
+};
+""" % (WAVETABLE_SIZE,
+       format_table(sine, "    "),
+       format_table(triangle, "    "),
+       format_levels(square),
+       format_levels(sawtooth))
+
+
+def write_if_changed(path, text):
+    # Only touch the file when the content changes, so incremental builds
+    # do not recompile it every time
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return
+    with open(path, "w") as f:
+        f.write(text)
+    print("gen_wavetables: wrote %s" % path)
+
+
+def project_dir():
+    try:
+        return env["PROJECT_DIR"]  # noqa: F821 (set when run by PlatformIO)
+    except NameError:
+        return os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+
+
+try:
+    Import("env")  # noqa: F821 (PlatformIO / SCons)
+except NameError:
+    pass
+
+write_if_changed(os.path.join(project_dir(), "src", "wavetables.c"), generate())
@@ -0,0 +1,41 @@
+# link_pico_multicore.py
+# Adds the Pico SDK's pico_multicore library to the device build: the
+# PlatformIO equivalent of CMake's
+#     target_link_libraries(theremin pico_multicore)
+# pipeline.c needs it to launch core 1 and to use the inter-core FIFO.
+#
+# Runs after the framework script (post: in platformio.ini), so it can
+# see whether the framework already builds the library, and it finds
+# the SDK in whichever installed package carries it.
+
+import os
+import sys
+
+Import("env")  # noqa: F821 (PlatformIO / SCons)
+
+MULTICORE_DIR = os.path.join("src", "rp2_common", "pico_multicore")
+
+
+def find_multicore_source(env):
+    # The SDK ships inside one of the platform's packages
+    platform = env.PioPlatform()
+    for name in platform.packages:
+        package_dir = platform.get_package_dir(name)
+        if package_dir and os.path.isdir(os.path.join(package_dir, MULTICORE_DIR)):
+            return os.path.join(package_dir, MULTICORE_DIR)
+    return None
+
+
+def already_built(env):
+    # Frameworks that build every SDK library put its headers on CPPPATH
+    return any("pico_multicore" in str(path) for path in env.get("CPPPATH", []))
+
+
+if not already_built(env):  # noqa: F821
+    source = find_multicore_source(env)  # noqa: F821
+    if source is None:
+        sys.stderr.write("link_pico_multicore: pico_multicore not found in any platform package\n")
+        env.Exit(1)  # noqa: F821
+    env.Append(CPPPATH=[os.path.join(source, "include")])  # noqa: F821
+    env.BuildSources(os.path.join("$BUILD_DIR", "pico_multicore"), source)  # noqa: F821
+    print("link_pico_multicore: building %s" % source)